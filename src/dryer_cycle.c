@@ -0,0 +1,151 @@
+/**
+ * 烘干周期核算实现，见 dryer_cycle.h。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "dryer_cycle.h"
+
+_Static_assert(CYCLE_HIST_BUCKETS == 6, "dryer_cycle_format_event prints exactly six histogram buckets");
+
+static const uint32_t g_hist_limit_min[CYCLE_HIST_BUCKETS - 1] = {15, 30, 60, 90, 120};
+
+void dryer_cycle_init(cycle_acct_t *acct)
+{
+    memset(acct, 0, sizeof(*acct));
+}
+
+/**
+ * @brief 将当前占空比从上次积分点累积到 now_ms
+ */
+static void cycle_accumulate(cycle_acct_t *acct, uint32_t now_ms)
+{
+    if (acct->active) {
+        acct->cur.motor_on_ms += (uint32_t)(((uint64_t)(now_ms - acct->duty_since_ms) * acct->duty) / 100U);
+    }
+    acct->duty_since_ms = now_ms;
+}
+
+static void cycle_push_pending(cycle_acct_t *acct, const cycle_summary_t *summary)
+{
+    uint32_t tail = (acct->pending_head + acct->pending_len) % CYCLE_PENDING_MAX;
+    acct->pending[tail] = *summary;
+    if (acct->pending_len == CYCLE_PENDING_MAX) {
+        acct->pending_head = (acct->pending_head + 1) % CYCLE_PENDING_MAX;  // 覆盖最旧
+    } else {
+        acct->pending_len++;
+    }
+}
+
+int dryer_cycle_update(cycle_acct_t *acct, const dryer_state_t *state, cycle_reason_t reason, uint32_t now_ms,
+                       cycle_summary_t *closed)
+{
+    if (state->running && !acct->active) {
+        // 新周期开始，导通时间从当前占空比重新积分
+        memset(&acct->cur, 0, sizeof(acct->cur));
+        acct->cur.seq = ++acct->seq;
+        acct->cur.start_ms = now_ms;
+        acct->cur.start_reason = (uint8_t)reason;
+        acct->cur.mode = (uint8_t)state->mode;
+        acct->cur.hum_start = state->humidity;
+        acct->active = 1;
+        acct->duty_since_ms = now_ms;
+        return 0;
+    }
+    if (state->running || !acct->active) {
+        return 0;
+    }
+
+    // 周期结束：结算导通时间、时长与直方图
+    cycle_accumulate(acct, now_ms);
+    acct->active = 0;
+    acct->cur.duration_ms = now_ms - acct->cur.start_ms;
+    acct->cur.stop_reason = (uint8_t)reason;
+    acct->cur.hum_end = state->humidity;
+
+    uint32_t minutes = acct->cur.duration_ms / 60000U;
+    int bucket = 0;
+    while (bucket < CYCLE_HIST_BUCKETS - 1 && minutes >= g_hist_limit_min[bucket]) {
+        bucket++;
+    }
+    acct->hist[bucket]++;
+
+    cycle_push_pending(acct, &acct->cur);
+    if (closed != NULL) {
+        *closed = acct->cur;
+    }
+    return 1;
+}
+
+void dryer_cycle_duty(cycle_acct_t *acct, uint8_t duty, uint32_t now_ms)
+{
+    cycle_accumulate(acct, now_ms);
+    acct->duty = duty;
+}
+
+void dryer_cycle_rebase(cycle_acct_t *acct, uint32_t saved_ms, uint32_t now_ms)
+{
+    uint32_t shift = now_ms - saved_ms;
+    acct->cur.start_ms += shift;
+    acct->duty_since_ms += shift;
+    for (uint32_t i = 0; i < acct->pending_len; i++) {
+        // 待上报周期的结束时刻也换算到本次上电的时基，上报时的 ended_ago 才连续
+        acct->pending[(acct->pending_head + i) % CYCLE_PENDING_MAX].start_ms += shift;
+    }
+    acct->duty = 0;  // 重启后电机尚未运行，由 motor_task 重新上报占空比
+}
+
+int dryer_cycle_peek(const cycle_acct_t *acct, cycle_summary_t *out)
+{
+    if (acct->pending_len == 0) {
+        return -1;
+    }
+    *out = acct->pending[acct->pending_head];
+    return 0;
+}
+
+void dryer_cycle_ack(cycle_acct_t *acct, uint32_t seq)
+{
+    if (acct->pending_len == 0 || acct->pending[acct->pending_head].seq != seq) {
+        return;
+    }
+    acct->pending_head = (acct->pending_head + 1) % CYCLE_PENDING_MAX;
+    acct->pending_len--;
+}
+
+const char *cycle_reason_to_string(cycle_reason_t reason)
+{
+    switch (reason) {
+        case CYCLE_REASON_KEY:
+            return "key";
+        case CYCLE_REASON_CLOUD:
+            return "cloud";
+        case CYCLE_REASON_HUMIDITY:
+            return "humidity";
+        case CYCLE_REASON_FAULT:
+            return "fault";
+        default:
+            return "none";
+    }
+}
+
+int dryer_cycle_format_event(const cycle_summary_t *summary, const uint32_t *hist, uint32_t now_ms, char *buffer,
+                             size_t len)
+{
+    uint32_t ended_ago = (now_ms - (summary->start_ms + summary->duration_ms)) / 1000U;
+    int n = snprintf(buffer, len,
+                     "{\"services\":[{\"service_id\":\"dryer\",\"event_type\":\"cycle_summary\",\"paras\":{"
+                     "\"seq\":%u,\"start\":\"%s\",\"stop\":\"%s\",\"mode\":\"%s\",\"duration\":%u,\"motor_on\":%u,"
+                     "\"hum_start\":%u,\"hum_end\":%u,\"ended_ago\":%u,\"hist\":[%u,%u,%u,%u,%u,%u]}}]}",
+                     (unsigned int)summary->seq, cycle_reason_to_string((cycle_reason_t)summary->start_reason),
+                     cycle_reason_to_string((cycle_reason_t)summary->stop_reason),
+                     mode_to_string((dry_mode_t)summary->mode), (unsigned int)(summary->duration_ms / 1000U),
+                     (unsigned int)(summary->motor_on_ms / 1000U), (unsigned int)summary->hum_start,
+                     (unsigned int)summary->hum_end, (unsigned int)ended_ago, (unsigned int)hist[0], (unsigned int)hist[1],
+                     (unsigned int)hist[2], (unsigned int)hist[3], (unsigned int)hist[4], (unsigned int)hist[5]);
+    if (n < 0 || (size_t)n >= len) {
+        return -1;
+    }
+    return 0;
+}
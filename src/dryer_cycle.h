@@ -0,0 +1,121 @@
+/**
+ * 烘干周期核算：记录每个烘干周期的启停原因、时长、电机导通时间与起止湿度，
+ * 并维护设备端的周期时长直方图。
+ *
+ * 本模块不依赖 RTOS，所有接口由调用方在持有状态锁时调用，时间由调用方传入。
+ */
+
+#ifndef DRYER_CYCLE_H
+#define DRYER_CYCLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dryer_logic.h"
+
+#define CYCLE_PENDING_MAX 4         // 待上报的周期汇总数，离线时覆盖最旧
+#define CYCLE_HIST_BUCKETS 6        // 时长直方图：<15 / <30 / <60 / <90 / <120 / ≥120 分钟
+
+typedef enum {
+    CYCLE_REASON_NONE = 0,
+    CYCLE_REASON_KEY,               // 本地按键
+    CYCLE_REASON_CLOUD,             // 云端命令
+    CYCLE_REASON_HUMIDITY,          // 湿度倒计时归零自动停机
+    CYCLE_REASON_FAULT,             // 连续热重启后监管停机
+    CYCLE_REASON_MAX
+} cycle_reason_t;
+
+typedef struct {
+    uint32_t seq;                   // 上电以来的周期序号，从 1 开始
+    uint32_t start_ms;              // 启动时刻（上电起毫秒）
+    uint32_t duration_ms;
+    uint32_t motor_on_ms;           // 按 PWM 占空比积分的电机导通时间
+    uint8_t start_reason;           // cycle_reason_t
+    uint8_t stop_reason;            // cycle_reason_t
+    uint8_t mode;                   // 启动时档位
+    uint8_t hum_start;
+    uint8_t hum_end;
+} cycle_summary_t;
+
+typedef struct {
+    int active;
+    cycle_summary_t cur;
+    uint8_t duty;                   // 当前电机占空比（%）
+    uint32_t duty_since_ms;         // 占空比积分起点
+    uint32_t seq;
+    uint32_t hist[CYCLE_HIST_BUCKETS];
+    cycle_summary_t pending[CYCLE_PENDING_MAX];
+    uint32_t pending_head;
+    uint32_t pending_len;
+} cycle_acct_t;
+
+/**
+ * @brief 初始化周期核算
+ */
+void dryer_cycle_init(cycle_acct_t *acct);
+
+/**
+ * @brief 状态提交后更新周期
+ * @param acct 周期核算
+ * @param state 提交后的状态
+ * @param reason 本次提交的原因
+ * @param now_ms 当前时刻（上电起毫秒）
+ * @param closed 输出参数，周期结束时写入汇总，可为NULL
+ * @return 本次提交结束了一个周期返回1，否则返回0
+ *
+ * 运行标志由 0→1 开始周期，由 1→0 结束周期并生成汇总
+ */
+int dryer_cycle_update(cycle_acct_t *acct, const dryer_state_t *state, cycle_reason_t reason, uint32_t now_ms,
+                       cycle_summary_t *closed);
+
+/**
+ * @brief 电机占空比变化时积分导通时间
+ * @param acct 周期核算
+ * @param duty 新占空比（%）
+ * @param now_ms 当前时刻（上电起毫秒）
+ */
+void dryer_cycle_duty(cycle_acct_t *acct, uint8_t duty, uint32_t now_ms);
+
+/**
+ * @brief 热重启恢复后平移时间戳，使进行中的周期跨重启连续累计
+ * @param acct 周期核算
+ * @param saved_ms 保存现场时的时刻（上一次上电起）
+ * @param now_ms 恢复时的时刻（本次上电起）
+ */
+void dryer_cycle_rebase(cycle_acct_t *acct, uint32_t saved_ms, uint32_t now_ms);
+
+/**
+ * @brief 读取最旧一条待上报的周期汇总，不移出队列
+ * @return 取到返回0，无待上报返回-1
+ */
+int dryer_cycle_peek(const cycle_acct_t *acct, cycle_summary_t *out);
+
+/**
+ * @brief 上报成功后移出周期汇总
+ * @param acct 周期核算
+ * @param seq 已上报的周期序号
+ *
+ * 仅当最旧一条仍是该周期时移出；上报期间队列已满被新周期覆盖时不动队列
+ */
+void dryer_cycle_ack(cycle_acct_t *acct, uint32_t seq);
+
+/**
+ * @brief 周期原因转字符串
+ */
+const char *cycle_reason_to_string(cycle_reason_t reason);
+
+/**
+ * @brief 将周期汇总格式化为 IoTDA 事件上报 JSON
+ * @param summary 周期汇总
+ * @param hist 直方图（CYCLE_HIST_BUCKETS 项）
+ * @param now_ms 上报时刻（上电起毫秒），用于计算周期结束距今的秒数 ended_ago
+ * @param buffer 输出缓冲区
+ * @param len 缓冲区长度
+ * @return 成功返回0，缓冲区不足返回-1
+ *
+ * 设备没有日历时钟，云端以消息的事件时间减去 ended_ago 得到周期结束的绝对时间，离线缓存后补报的周期也能落在正确时刻
+ */
+int dryer_cycle_format_event(const cycle_summary_t *summary, const uint32_t *hist, uint32_t now_ms, char *buffer,
+                             size_t len);
+
+#endif /* DRYER_CYCLE_H */
@@ -0,0 +1,74 @@
+/**
+ * 烘干控制核心逻辑实现，见 dryer_logic.h。
+ */
+
+#include "dryer_logic.h"
+
+const char *mode_to_string(dry_mode_t mode)
+{
+    switch (mode) {
+        case DRY_MODE_FAST:
+            return "Fast";        // 快速烘干模式
+        case DRY_MODE_STANDARD:
+            return "Standard";   // 标准烘干模式
+        case DRY_MODE_SOFT:
+            return "Soft";        // 温柔烘干模式
+        default:
+            return "Standard";   // 默认标准模式
+    }
+}
+
+/**
+ * @brief 设置运行状态，停止时重置倒计时
+ */
+static void dryer_set_running(dryer_state_t *state, int running)
+{
+    state->running = running ? 1 : 0;
+    if (!running) {
+        state->countdown = -1;
+    }
+}
+
+void dryer_apply_input(dryer_state_t *state, dryer_input_t input, int arg)
+{
+    switch (input) {
+        case DRYER_INPUT_START:
+            dryer_set_running(state, 1);
+            break;
+        case DRYER_INPUT_STOP:
+            dryer_set_running(state, 0);
+            break;
+        case DRYER_INPUT_TOGGLE:
+            dryer_set_running(state, !state->running);
+            break;
+        case DRYER_INPUT_SET_MODE:
+            // 参数有效性检查，超出范围时自动切换到快速模式
+            state->mode = (arg >= 0 && arg < DRY_MODE_MAX) ? (dry_mode_t)arg : DRY_MODE_FAST;
+            break;
+        case DRYER_INPUT_NEXT_MODE:
+            state->mode = (dry_mode_t)((state->mode + 1) % DRY_MODE_MAX);  // 循环切换
+            break;
+        default:
+            break;
+    }
+}
+
+int dryer_sensor_step(dryer_state_t *state, uint8_t temp, uint8_t hum)
+{
+    state->temperature = temp;
+    state->humidity = hum;
+
+    if (!state->running || hum > HUMIDITY_THRESHOLD) {
+        state->countdown = -1;  // 未运行或湿度未达标，重置倒计时
+        return 0;
+    }
+    if (state->countdown < 0) {
+        state->countdown = COUNTDOWN_SECONDS;  // 湿度达到阈值，开始倒计时
+    } else if (state->countdown > 0) {
+        state->countdown -= 1;  // 倒计时递减
+    } else {
+        dryer_set_running(state, 0);  // 倒计时结束，停止烘干
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * 烘干控制核心逻辑：状态定义、输入事件与湿度倒计时判定。
+ *
+ * 本模块不依赖 RTOS 与外设，调用方负责加锁；设备端与主机端回放工具共用同一实现。
+ */
+
+#ifndef DRYER_LOGIC_H
+#define DRYER_LOGIC_H
+
+#include <stdint.h>
+
+#define HUMIDITY_THRESHOLD 40
+#define COUNTDOWN_SECONDS 10
+#define SENSOR_PERIOD_MS 1000
+
+typedef enum {
+    DRY_MODE_FAST = 0,
+    DRY_MODE_STANDARD,
+    DRY_MODE_SOFT,
+    DRY_MODE_MAX
+} dry_mode_t;
+
+typedef struct {
+    int running;
+    dry_mode_t mode;
+    uint8_t humidity;
+    uint8_t temperature;
+    int countdown;
+} dryer_state_t;
+
+// 改变运行状态或档位的输入（按键、云端命令）
+typedef enum {
+    DRYER_INPUT_START = 0,
+    DRYER_INPUT_STOP,
+    DRYER_INPUT_TOGGLE,
+    DRYER_INPUT_SET_MODE,     // 参数为 dry_mode_t，越界时回落到快速模式
+    DRYER_INPUT_NEXT_MODE,
+    DRYER_INPUT_MAX
+} dryer_input_t;
+
+/**
+ * @brief 将烘干模式枚举转换为人类可读的字符串
+ * @param mode 烘干模式枚举值
+ * @return 对应的模式字符串
+ */
+const char *mode_to_string(dry_mode_t mode);
+
+/**
+ * @brief 应用一次输入事件
+ * @param state 烘干状态
+ * @param input 输入类型
+ * @param arg 输入参数（仅 DRYER_INPUT_SET_MODE 使用）
+ *
+ * 停止时重置倒计时
+ */
+void dryer_apply_input(dryer_state_t *state, dryer_input_t input, int arg);
+
+/**
+ * @brief 处理一次温湿度采样
+ * @param state 烘干状态
+ * @param temp 温度值
+ * @param hum 湿度值
+ * @return 本次采样倒计时归零并停机返回1，否则返回0
+ *
+ * 运行中湿度 ≤ 阈值时开始/递减倒计时，归零后停机；湿度回升或未运行时重置倒计时
+ */
+int dryer_sensor_step(dryer_state_t *state, uint8_t temp, uint8_t hum);
+
+#endif /* DRYER_LOGIC_H */
@@ -0,0 +1,111 @@
+/**
+ * 任务健康监管实现，见 dryer_supervisor.h。
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "dryer_supervisor.h"
+
+void sup_init(supervisor_t *sup)
+{
+    memset(sup, 0, sizeof(*sup));
+}
+
+void sup_config(supervisor_t *sup, int id, const char *name, uint32_t deadline_ms)
+{
+    if (id < 0 || id >= SUP_TASK_MAX) {
+        return;
+    }
+    sup->entries[id].name = name;
+    sup->entries[id].deadline_ms = deadline_ms;
+}
+
+void sup_start(supervisor_t *sup, int id, uint32_t now_ms)
+{
+    if (id < 0 || id >= SUP_TASK_MAX) {
+        return;
+    }
+    sup->entries[id].last_beat_ms = now_ms;
+    sup->entries[id].active = 1;
+}
+
+void sup_beat(supervisor_t *sup, int id, uint32_t now_ms)
+{
+    if (id >= 0 && id < SUP_TASK_MAX) {
+        sup->entries[id].last_beat_ms = now_ms;
+    }
+}
+
+int sup_check(const supervisor_t *sup, uint32_t now_ms, uint32_t *silent_ms)
+{
+    for (int i = 0; i < SUP_TASK_MAX; i++) {
+        const sup_entry_t *entry = &sup->entries[i];
+        if (!entry->active || entry->deadline_ms == 0) {
+            continue;
+        }
+        uint32_t silent = now_ms - entry->last_beat_ms;
+        // 心跳时间晚于检查时刻（并发写入）时差值回绕为大数，按健康处理
+        if (silent > entry->deadline_ms && silent < 0x80000000U) {
+            if (silent_ms != NULL) {
+                *silent_ms = silent;
+            }
+            return i;
+        }
+    }
+    return -1;
+}
+
+int sup_allow_restart(supervisor_t *sup, int id, uint32_t now_ms, uint32_t window_ms, uint8_t max_restarts)
+{
+    if (id < 0 || id >= SUP_TASK_MAX) {
+        return 0;
+    }
+    sup_entry_t *entry = &sup->entries[id];
+    if (entry->restarts == 0 || now_ms - entry->window_start_ms > window_ms) {
+        entry->window_start_ms = now_ms;
+        entry->restarts = 0;
+    }
+    if (entry->restarts >= max_restarts) {
+        return 0;
+    }
+    entry->restarts++;
+    return 1;
+}
+
+/**
+ * @brief 计算保留区校验和（不含 checksum 字段），FNV-1a
+ */
+static uint32_t retained_checksum(const sup_retained_t *retained)
+{
+    const uint8_t *p = (const uint8_t *)retained;
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < offsetof(sup_retained_t, checksum); i++) {
+        hash = (hash ^ p[i]) * 16777619U;
+    }
+    return hash;
+}
+
+void sup_retained_seal(sup_retained_t *retained)
+{
+    retained->magic = SUP_RETAINED_MAGIC;
+    retained->checksum = retained_checksum(retained);
+}
+
+int sup_retained_valid(const sup_retained_t *retained)
+{
+    return retained->magic == SUP_RETAINED_MAGIC && retained->checksum == retained_checksum(retained) &&
+           retained->reason < SUP_RESET_MAX;
+}
+
+const char *sup_reset_reason_to_string(sup_reset_reason_t reason)
+{
+    switch (reason) {
+        case SUP_RESET_TASK_HANG:
+            return "task_hang";
+        case SUP_RESET_UNEXPECTED:
+            return "unexpected";
+        default:
+            return "power_on";
+    }
+}
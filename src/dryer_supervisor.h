@@ -0,0 +1,136 @@
+/**
+ * 任务健康监管：为每个任务登记心跳期限，检测超时任务，并在 RAM 中保留跨热重启的运行现场。
+ *
+ * 本模块不依赖 RTOS，时间由调用方传入；看门狗、任务重启与重启动作由调用方实现。
+ */
+
+#ifndef DRYER_SUPERVISOR_H
+#define DRYER_SUPERVISOR_H
+
+#include <stdint.h>
+
+#include "dryer_cycle.h"
+#include "dryer_logic.h"
+
+#define SUP_TASK_MAX 8
+#define SUP_NAME_LEN 16
+#define SUP_RETAINED_MAGIC 0x534C5254U  // "SLRT"
+
+#define SUP_PERIOD_MS 100               // 监管检查周期
+#define SUP_SNAPSHOT_MS 1000            // 保留区现场刷新周期
+#define SUP_RESTART_WINDOW_MS 60000
+#define SUP_MAX_RESTARTS 2              // 窗口内单任务最多重启次数，超过则热重启
+#define SUP_STOP_GRACE_MS 500           // 等待超时任务在心跳点自行退出的时长，超过则热重启
+#define SUP_STOP_POLL_MS 10
+#define SUP_MAX_WARM_BOOTS 3            // 连续热重启超过该次数时按停机状态恢复，避免卡死-重启循环中电机一直运转
+#define SUP_HEALTHY_RUN_MS 600000       // 本次上电持续运行该时长后清零连续热重启计数
+
+// 各任务心跳期限（毫秒），取任务最长正常循环周期的数倍
+#define SUP_DEADLINE_CTRL 3000
+#define SUP_DEADLINE_MOTOR 500
+#define SUP_DEADLINE_KEYS 1000
+#define SUP_DEADLINE_OLED 2000
+#define SUP_DEADLINE_MQTT_SEND 10000
+// MQTTClient_sub 阻塞到有下行消息为止，空闲设备可以长时间收不到消息，心跳间隔不反映任务健康，不受监管；
+// 断链时 mqtt_send 连续 MQTT_PUB_FAIL_MAX 次发布失败后停止心跳，由其期限检出
+#define SUP_DEADLINE_MQTT_RECV 0
+
+typedef enum {
+    SUP_TASK_CTRL = 0,
+    SUP_TASK_MOTOR,
+    SUP_TASK_KEYS,
+    SUP_TASK_OLED,
+    SUP_TASK_MQTT_SEND,
+    SUP_TASK_MQTT_RECV,
+    SUP_TASK_COUNT
+} sup_task_id_t;
+
+typedef enum {
+    SUP_RESET_POWER_ON = 0,     // 保留区无效：上电冷启动
+    SUP_RESET_TASK_HANG,        // 监管发现任务超时且无法单独重启，主动热重启
+    SUP_RESET_UNEXPECTED,       // 保留区有效但未记录原因：硬件看门狗、异常或复位键
+    SUP_RESET_MAX
+} sup_reset_reason_t;
+
+typedef struct {
+    const char *name;
+    uint32_t deadline_ms;               // 两次心跳的最大间隔，0 表示不受监管
+    volatile uint32_t last_beat_ms;     // 由任务自身写入
+    uint8_t active;                     // 0 表示未启动或不受监管
+    uint8_t restarts;                   // 当前窗口内的重启次数
+    uint32_t window_start_ms;
+} sup_entry_t;
+
+typedef struct {
+    sup_entry_t entries[SUP_TASK_MAX];
+} supervisor_t;
+
+// 热重启后保留的现场，需放在启动代码不清零的 RAM 段
+typedef struct {
+    uint32_t magic;
+    uint32_t warm_boots;                // 连续热重启次数（两次之间运行不足 SUP_HEALTHY_RUN_MS）
+    uint32_t saved_ms;                  // 保存时刻（上电起毫秒），用于恢复时平移周期时间戳
+    uint8_t reason;                     // sup_reset_reason_t
+    char task[SUP_NAME_LEN];            // 引发重启的任务
+    dryer_state_t state;
+    cycle_acct_t cycle;
+    uint32_t checksum;
+} sup_retained_t;
+
+/**
+ * @brief 初始化监管表
+ */
+void sup_init(supervisor_t *sup);
+
+/**
+ * @brief 登记任务名称与心跳期限
+ */
+void sup_config(supervisor_t *sup, int id, const char *name, uint32_t deadline_ms);
+
+/**
+ * @brief 开始监管任务（任务创建或重启时调用）
+ */
+void sup_start(supervisor_t *sup, int id, uint32_t now_ms);
+
+/**
+ * @brief 任务心跳
+ */
+void sup_beat(supervisor_t *sup, int id, uint32_t now_ms);
+
+/**
+ * @brief 检查超时任务
+ * @param sup 监管表
+ * @param now_ms 当前时刻
+ * @param silent_ms 输出参数，超时任务距上次心跳的时长，可为NULL
+ * @return 第一个超时任务的ID，全部健康返回-1
+ */
+int sup_check(const supervisor_t *sup, uint32_t now_ms, uint32_t *silent_ms);
+
+/**
+ * @brief 记录一次任务重启并判断是否仍允许单独重启
+ * @param sup 监管表
+ * @param id 任务ID
+ * @param now_ms 当前时刻
+ * @param window_ms 统计窗口
+ * @param max_restarts 窗口内允许的最大重启次数
+ * @return 允许重启返回1，超过次数（应升级为热重启）返回0
+ */
+int sup_allow_restart(supervisor_t *sup, int id, uint32_t now_ms, uint32_t window_ms, uint8_t max_restarts);
+
+/**
+ * @brief 计算校验和并写入保留区
+ */
+void sup_retained_seal(sup_retained_t *retained);
+
+/**
+ * @brief 检查保留区是否有效
+ * @return 有效返回1，否则返回0
+ */
+int sup_retained_valid(const sup_retained_t *retained);
+
+/**
+ * @brief 重启原因转字符串
+ */
+const char *sup_reset_reason_to_string(sup_reset_reason_t reason);
+
+#endif /* DRYER_SUPERVISOR_H */
@@ -0,0 +1,257 @@
+/**
+ * 烘干事件追踪实现，见 dryer_trace.h。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+
+#include "dryer_trace.h"
+#include "smart_laundry_mem.h"
+
+#define TRACE_DUMP_PER_LINE 16
+
+static dryer_trace_rec_t g_trace_buf[TRACE_CAPACITY];
+static uint32_t g_trace_head;       // 下一条写入位置
+static uint32_t g_trace_len;        // 环内有效记录数
+static uint32_t g_trace_seq;        // 下一条记录的序号，单调递增
+static uint32_t g_trace_sealed;     // 序号小于该值的记录已被导出，不再合并
+static dryer_state_t g_trace_base;      // 被覆盖的记录推进到的状态，导出时作为回放起点
+static uint32_t g_trace_base_ms;        // 基准状态对应的时刻（最后一条被覆盖记录的虚拟时刻）
+static int g_trace_has_base;            // 已有状态记录被覆盖，基准状态有效
+static int g_trace_last_state = -1;     // 最近一次状态提交的编码，-1 表示尚未记录
+static osMutexId_t g_trace_lock;
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+SL_CB_ARRAY(g_trace_lock_cb, SL_MUTEX_CB_SIZE);
+static const osMutexAttr_t g_trace_lock_attr = {
+    .name = "trace", .cb_mem = SL_CB_MEM(g_trace_lock_cb), .cb_size = SL_CB_BYTES(g_trace_lock_cb)
+};
+#define TRACE_LOCK_ATTR (&g_trace_lock_attr)
+#else
+#define TRACE_LOCK_ATTR NULL
+#endif
+
+/**
+ * @brief 获取上电以来的毫秒数
+ */
+static uint32_t trace_now_ms(void)
+{
+    uint32_t freq = osKernelGetTickFreq();
+    if (freq == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)osKernelGetTickCount() * 1000U) / freq);
+}
+
+/**
+ * @brief 将一条被覆盖的记录并入基准状态（调用方持有追踪锁）
+ *
+ * 规则与 tools/trace_replay.c 的回放相同：状态记录直接采用，采样与输入经 dryer_logic 推进。
+ * 倒计时不单独记录，只保存最近的状态记录会丢掉它之后已被覆盖的采样，回放从回绕处开始时倒计时与设备不符
+ */
+static void trace_fold(const dryer_trace_rec_t *rec)
+{
+    g_trace_base_ms = rec->ts_ms;
+    switch (rec->type) {
+        case TRACE_EVT_STATE:
+            g_trace_base.running = rec->a & 1U;
+            g_trace_base.mode = (dry_mode_t)(rec->a >> 1);
+            g_trace_base.countdown = rec->b;
+            g_trace_has_base = 1;
+            break;
+        case TRACE_EVT_SENSOR: {
+            uint32_t repeat = ((uint16_t)rec->b >> 8) + 1U;
+            for (uint32_t k = 0; g_trace_has_base && k < repeat; k++) {
+                (void)dryer_sensor_step(&g_trace_base, (uint8_t)rec->b, rec->a);
+            }
+            g_trace_base_ms = rec->ts_ms + (repeat - 1U) * SENSOR_PERIOD_MS;
+            break;
+        }
+        case TRACE_EVT_KEY:
+        case TRACE_EVT_CLOUD:
+            if (g_trace_has_base) {
+                dryer_apply_input(&g_trace_base, (dryer_input_t)rec->a, rec->b);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 写入一条记录（调用方持有追踪锁）
+ */
+static void trace_push(const dryer_trace_rec_t *rec)
+{
+    if (g_trace_len == TRACE_CAPACITY) {
+        // 覆盖最旧记录前将其并入基准状态，保证导出内容总能从已知状态开始回放
+        trace_fold(&g_trace_buf[g_trace_head]);
+    } else {
+        g_trace_len++;
+    }
+    g_trace_buf[g_trace_head] = *rec;
+    g_trace_head = (g_trace_head + 1) % TRACE_CAPACITY;
+    g_trace_seq++;
+}
+
+/**
+ * @brief 取从末尾倒数第 back 条记录，该记录已导出或不在环内时返回 NULL（调用方持有追踪锁）
+ */
+static dryer_trace_rec_t *trace_open_rec(uint32_t back)
+{
+    if (back > g_trace_len || back > g_trace_seq - g_trace_sealed) {
+        return NULL;
+    }
+    return &g_trace_buf[(g_trace_head + TRACE_CAPACITY - back) % TRACE_CAPACITY];
+}
+
+/**
+ * @brief 将一条记录以十六进制追加到 buf[*pos]
+ */
+static void trace_append_hex(const dryer_trace_rec_t *rec, char *buf, size_t *pos)
+{
+    static const char hex[] = "0123456789abcdef";
+    uint8_t raw[DRYER_TRACE_REC_SIZE];
+
+    dryer_trace_encode(rec, raw);
+    for (int i = 0; i < DRYER_TRACE_REC_SIZE; i++) {
+        buf[(*pos)++] = hex[raw[i] >> 4];
+        buf[(*pos)++] = hex[raw[i] & 0x0F];
+    }
+}
+
+int dryer_trace_init(void)
+{
+    g_trace_lock = osMutexNew(TRACE_LOCK_ATTR);
+    if (g_trace_lock == NULL) {
+        printf("[trace] mutex create failed\r\n");
+        return -1;
+    }
+#ifdef SMART_LAUNDRY_STATIC_MEM
+    if (!sl_static_mem_inside(g_trace_lock, SL_CB_MEM(g_trace_lock_cb), SL_CB_BYTES(g_trace_lock_cb))) {
+        printf("[mem] trace: kernel ignored cb_mem\r\n");
+    }
+#endif
+    dryer_trace_record(TRACE_EVT_BOOT, DRYER_TRACE_VERSION, 0);
+    return 0;
+}
+
+void dryer_trace_record(trace_evt_t type, uint8_t a, int16_t b)
+{
+    if (g_trace_lock == NULL) {
+        return;
+    }
+    dryer_trace_rec_t rec = {
+        .ts_ms = trace_now_ms(),
+        .type = (uint8_t)type,
+        .a = a,
+        .b = b
+    };
+
+    osMutexAcquire(g_trace_lock, osWaitForever);
+    // 对控制逻辑等价的采样与连续读取失败只累加次数，带噪声或偶发读取失败的长时间烘干也不会占满缓冲区
+    if (!dryer_trace_merge(trace_open_rec(2), trace_open_rec(1), rec.type, a)) {
+        trace_push(&rec);
+    }
+    osMutexRelease(g_trace_lock);
+}
+
+void dryer_trace_state(const dryer_state_t *state)
+{
+    uint8_t code = dryer_trace_state_code(state);
+    int16_t countdown = (int16_t)state->countdown;
+
+    // 倒计时的逐秒变化完全由采样序列决定，回放时推算并在下一次启停/换档处核对，不单独记录
+    if (g_trace_last_state == code) {
+        return;
+    }
+    g_trace_last_state = code;
+    dryer_trace_record(TRACE_EVT_STATE, code, countdown);
+}
+
+uint32_t dryer_trace_count(void)
+{
+    if (g_trace_lock == NULL) {
+        return 0;
+    }
+    osMutexAcquire(g_trace_lock, osWaitForever);
+    uint32_t count = g_trace_len + (g_trace_has_base ? 1U : 0U);
+    osMutexRelease(g_trace_lock);
+    return count;
+}
+
+uint32_t dryer_trace_export_hex(uint32_t seq, uint32_t count, char *buf, size_t len, dryer_trace_page_t *page)
+{
+    uint32_t done = 0;
+    size_t pos = 0;
+
+    memset(page, 0, sizeof(*page));
+    if (buf == NULL || len == 0) {
+        return 0;
+    }
+    buf[0] = '\0';
+    if (g_trace_lock == NULL) {
+        return 0;
+    }
+
+    osMutexAcquire(g_trace_lock, osWaitForever);
+    uint32_t oldest = g_trace_seq - g_trace_len;
+    int with_base = 0;
+    if (seq == DRYER_TRACE_SEQ_OLDEST || (int32_t)(seq - oldest) < 0) {
+        // 从头读取或请求的记录已被覆盖：从最旧记录重新开始，并以基准状态作为回放起点
+        page->lost = seq == DRYER_TRACE_SEQ_OLDEST ? 0 : oldest - seq;
+        seq = oldest;
+        with_base = g_trace_has_base;
+    } else if ((int32_t)(seq - g_trace_seq) > 0) {
+        seq = g_trace_seq;
+    }
+    page->first = seq;
+
+    if (with_base && count > 0 && pos + DRYER_TRACE_REC_SIZE * 2 < len) {
+        dryer_trace_rec_t base = {
+            .ts_ms = g_trace_base_ms,
+            .type = TRACE_EVT_STATE,
+            .a = dryer_trace_state_code(&g_trace_base),
+            .b = (int16_t)g_trace_base.countdown
+        };
+        trace_append_hex(&base, buf, &pos);
+        done++;
+    }
+    while (done < count && seq != g_trace_seq && pos + DRYER_TRACE_REC_SIZE * 2 < len) {
+        uint32_t back = g_trace_seq - seq;
+        trace_append_hex(&g_trace_buf[(g_trace_head + TRACE_CAPACITY - back) % TRACE_CAPACITY], buf, &pos);
+        seq++;
+        done++;
+    }
+    if (seq == g_trace_seq) {
+        g_trace_sealed = g_trace_seq;  // 最新记录已被读走，之后的采样另起一条
+    }
+    page->next = seq;
+    page->head = g_trace_seq;
+    page->count = done;
+    osMutexRelease(g_trace_lock);
+    buf[pos] = '\0';
+    return done;
+}
+
+void dryer_trace_dump(void)
+{
+    char line[TRACE_DUMP_PER_LINE * DRYER_TRACE_REC_SIZE * 2 + 1];
+    dryer_trace_page_t page;
+    uint32_t seq = DRYER_TRACE_SEQ_OLDEST;
+
+    printf("[trace] begin v%d records=%u\r\n", DRYER_TRACE_VERSION, (unsigned int)dryer_trace_count());
+    while (dryer_trace_export_hex(seq, TRACE_DUMP_PER_LINE, line, sizeof(line), &page) > 0) {
+        if (page.lost != 0) {
+            printf("[trace] lost %u records, restart\r\n", (unsigned int)page.lost);
+        }
+        printf("[trace] %s\r\n", line);
+        seq = page.next;
+        if (page.next == page.head) {
+            break;
+        }
+    }
+    printf("[trace] end\r\n");
+}
@@ -0,0 +1,190 @@
+/**
+ * 烘干事件追踪：定长二进制记录的环形缓冲区，记录采样、按键、云端命令、状态提交与电机占空比。
+ *
+ * 导出格式为记录按 8 字节小端编码后的十六进制串（见 dryer_trace_encode），
+ * 主机端 tools/trace_replay.c 读取该格式并在虚拟时钟上回放 dryer_logic 的控制逻辑。
+ */
+
+#ifndef DRYER_TRACE_H
+#define DRYER_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dryer_logic.h"
+
+#define DRYER_TRACE_VERSION 2        // 2：读取失败合并计数，基准状态由被覆盖的记录推算
+#define DRYER_TRACE_REC_SIZE 8
+#define TRACE_HUM_DEADBAND 3        // 采样合并允许的湿度偏离（%RH），覆盖 DHT11 的 ±1 抖动
+
+typedef enum {
+    TRACE_EVT_BOOT = 1,      // a=格式版本
+    TRACE_EVT_SENSOR,        // a=湿度，b 低字节=温度、高字节=并入的后续采样数（见 dryer_trace_sensor_mergeable）
+    TRACE_EVT_SENSOR_FAIL,   // DHT11 读取失败，b=连续失败次数（见 dryer_trace_merge）
+    TRACE_EVT_KEY,           // a=dryer_input_t，b=输入参数
+    TRACE_EVT_CLOUD,         // a=dryer_input_t，b=输入参数
+    TRACE_EVT_STATE,         // a=运行标志|档位<<1，b=倒计时；仅在启停或档位变化时记录
+    TRACE_EVT_DUTY,          // a=电机占空比（%）
+    TRACE_EVT_FAULT,         // a=超时任务ID（sup_task_id_t），b=是否单独重启
+    TRACE_EVT_MAX
+} trace_evt_t;
+
+typedef struct {
+    uint32_t ts_ms;          // 上电起毫秒
+    uint8_t type;            // trace_evt_t
+    uint8_t a;
+    int16_t b;
+} dryer_trace_rec_t;
+
+/**
+ * @brief 按小端格式编码一条记录
+ */
+static inline void dryer_trace_encode(const dryer_trace_rec_t *rec, uint8_t out[DRYER_TRACE_REC_SIZE])
+{
+    out[0] = (uint8_t)(rec->ts_ms);
+    out[1] = (uint8_t)(rec->ts_ms >> 8);
+    out[2] = (uint8_t)(rec->ts_ms >> 16);
+    out[3] = (uint8_t)(rec->ts_ms >> 24);
+    out[4] = rec->type;
+    out[5] = rec->a;
+    out[6] = (uint8_t)((uint16_t)rec->b);
+    out[7] = (uint8_t)((uint16_t)rec->b >> 8);
+}
+
+/**
+ * @brief 解码一条小端格式记录
+ */
+static inline void dryer_trace_decode(const uint8_t in[DRYER_TRACE_REC_SIZE], dryer_trace_rec_t *rec)
+{
+    rec->ts_ms = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+    rec->type = in[4];
+    rec->a = in[5];
+    rec->b = (int16_t)((uint16_t)in[6] | ((uint16_t)in[7] << 8));
+}
+
+/**
+ * @brief 判断一次采样能否并入上一条采样记录
+ * @param last 上一条记录
+ * @param hum 新采样的湿度
+ * @return 可以合并返回1，否则返回0
+ *
+ * 控制逻辑只看湿度是否高于阈值，温度不参与判定：与记录值处在阈值同一侧、且偏离不超过
+ * TRACE_HUM_DEADBAND 的采样按记录值回放结果完全相同，只累加重复次数。传感器抖动因此不会
+ * 拆分记录，记录数只随湿度的实际漂移与阈值穿越增长
+ */
+static inline int dryer_trace_sensor_mergeable(const dryer_trace_rec_t *last, uint8_t hum)
+{
+    int diff = (int)hum - (int)last->a;
+
+    return last->type == TRACE_EVT_SENSOR && ((uint16_t)last->b >> 8) < 0xFFU &&
+           (hum > HUMIDITY_THRESHOLD) == (last->a > HUMIDITY_THRESHOLD) &&
+           diff >= -TRACE_HUM_DEADBAND && diff <= TRACE_HUM_DEADBAND;
+}
+
+/**
+ * @brief 尝试把一条新记录并入末尾的记录（设备端记录器与回放工具的模拟周期共用）
+ * @param prev last 之前的一条记录，已导出或不存在时为 NULL
+ * @param last 最新一条记录，已导出或不存在时为 NULL
+ * @param type 新记录的事件类型
+ * @param a 新记录的 a 字段
+ * @return 已合并返回1，需要追加新记录返回0
+ *
+ * 连续的读取失败只累加 last 的失败次数。读取失败不调用控制逻辑，紧随失败的采样可越过失败记录并入
+ * 之前的采样记录，DHT11 偶发读取失败不会拆分采样记录；回放时并入的采样按采样周期展开，
+ * 其虚拟时刻会比实际提前所跨过的失败次数个周期
+ */
+static inline int dryer_trace_merge(dryer_trace_rec_t *prev, dryer_trace_rec_t *last, uint8_t type, uint8_t a)
+{
+    if (last == NULL) {
+        return 0;
+    }
+    if (type == TRACE_EVT_SENSOR_FAIL) {
+        if (last->type != TRACE_EVT_SENSOR_FAIL || last->b == INT16_MAX) {
+            return 0;
+        }
+        last->b++;
+        return 1;
+    }
+    if (type != TRACE_EVT_SENSOR) {
+        return 0;
+    }
+    if (last->type == TRACE_EVT_SENSOR_FAIL && prev != NULL) {
+        last = prev;
+    }
+    if (!dryer_trace_sensor_mergeable(last, a)) {
+        return 0;
+    }
+    last->b = (int16_t)((uint16_t)last->b + 0x100U);
+    return 1;
+}
+
+/**
+ * @brief 状态提交记录的 a 字段编码
+ */
+static inline uint8_t dryer_trace_state_code(const dryer_state_t *state)
+{
+    return (uint8_t)((state->running ? 1U : 0U) | ((uint32_t)state->mode << 1));
+}
+
+#define DRYER_TRACE_SEQ_OLDEST 0xFFFFFFFFU  // 导出起始序号：从最旧记录开始
+
+/**
+ * 一次分段导出的位置信息。记录序号自启动起单调递增，与环内位置无关，
+ * 分段拉取期间新写入或被覆盖的记录不会让已拉取的段错位
+ */
+typedef struct {
+    uint32_t first;          // 本段首条环内记录的序号
+    uint32_t next;           // 下一段的起始序号
+    uint32_t head;           // 导出时最新记录的下一个序号，next == head 表示已读完
+    uint32_t lost;           // 请求序号之前已被覆盖的记录数；非0时本段以基准状态重新开始，已拼接的数据应丢弃
+    uint32_t count;          // 本段导出的记录数（含开头的基准状态记录）
+} dryer_trace_page_t;
+
+/**
+ * @brief 初始化追踪缓冲区并写入启动记录
+ * @return 成功返回0，锁创建失败返回-1（此后记录被忽略）
+ */
+int dryer_trace_init(void);
+
+/**
+ * @brief 追加一条记录，缓冲区满时覆盖最旧记录
+ * @param type 事件类型
+ * @param a 事件参数
+ * @param b 事件参数
+ *
+ * 对控制逻辑等价的连续采样与连续的读取失败合并为一条记录（dryer_trace_merge）；
+ * 已导出的记录不再合并，保证分段导出的内容不会事后变化
+ */
+void dryer_trace_record(trace_evt_t type, uint8_t a, int16_t b);
+
+/**
+ * @brief 记录一次状态提交，运行标志与档位与上次提交相同则忽略
+ * @param state 提交后的状态（调用方持有状态锁）
+ */
+void dryer_trace_state(const dryer_state_t *state);
+
+/**
+ * @brief 当前可导出的记录数
+ */
+uint32_t dryer_trace_count(void);
+
+/**
+ * @brief 按记录序号导出一段记录为十六进制串
+ * @param seq 起始序号，取上一段的 page->next；DRYER_TRACE_SEQ_OLDEST 从最旧记录开始
+ * @param count 期望导出的记录数
+ * @param buf 输出缓冲区，以 '\0' 结尾
+ * @param len 缓冲区长度
+ * @param page 输出本段的序号信息
+ * @return 实际导出的记录数
+ *
+ * 从最旧记录开始（或请求的记录已被覆盖）时，段首附带一条基准状态记录作为回放起点：从最早被覆盖的
+ * 状态记录起，按回放规则推进全部被覆盖的记录得到的状态，倒计时中发生回绕时也带有覆盖时刻的倒计时
+ */
+uint32_t dryer_trace_export_hex(uint32_t seq, uint32_t count, char *buf, size_t len, dryer_trace_page_t *page);
+
+/**
+ * @brief 以十六进制行打印全部记录到串口，每行以 "[trace] " 开头
+ */
+void dryer_trace_dump(void);
+
+#endif /* DRYER_TRACE_H */
@@ -20,12 +20,33 @@
 #include "bsp_mqtt.h"
 #include "bsp_led.h"
 
+#include "iot_watchdog.h"
+#include "hi_mem.h"
+#include "hi_reset.h"
+#include "kv_store.h"
+
 #include "lwip/netifapi.h"
 #include "lwip/sockets.h"
 #include "lwip/api_shell.h"
 
 #include "cJSON.h"
 
+#include "dryer_cycle.h"
+#include "dryer_logic.h"
+#include "dryer_supervisor.h"
+#include "dryer_trace.h"
+#include "smart_laundry_mem.h"
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+// 静态内存模式：本文件内直接调用堆分配函数将在编译期报错
+#pragma GCC poison malloc calloc realloc free
+_Static_assert(SL_THREAD_CB_SIZE >= sizeof(LosTaskCB), "SL_THREAD_CB_SIZE smaller than LosTaskCB");
+_Static_assert(SL_MUTEX_CB_SIZE >= sizeof(LosMuxCB), "SL_MUTEX_CB_SIZE smaller than LosMuxCB");
+_Static_assert(SL_SEM_CB_SIZE >= sizeof(LosSemCB), "SL_SEM_CB_SIZE smaller than LosSemCB");
+_Static_assert(SL_EVENT_CB_SIZE >= sizeof(EVENT_CB_S), "SL_EVENT_CB_SIZE smaller than EVENT_CB_S");
+_Static_assert(SL_MQ_CB_SIZE >= sizeof(LosQueueCB), "SL_MQ_CB_SIZE smaller than LosQueueCB");
+#endif
+
 #define WIFI_SSID "wnb"
 #define WIFI_PAWD "88888888"
 
@@ -39,28 +60,53 @@
 #define MQTT_TOPIC_SUB_COMMANDS "$oc/devices/%s/sys/commands/#"
 #define MQTT_TOPIC_PUB_COMMANDS_REQ "$oc/devices/%s/sys/commands/response/request_id=%s"
 #define MQTT_TOPIC_PUB_PROPERTIES "$oc/devices/%s/sys/properties/report"
+#define MQTT_TOPIC_PUB_EVENTS "$oc/devices/%s/sys/events/up"
 
-#define HUMIDITY_THRESHOLD 40
-#define COUNTDOWN_SECONDS 10
-#define SENSOR_PERIOD_MS 1000
 #define MQTT_SEND_INTERVAL_SEC 3
+#define MQTT_PUB_FAIL_MAX 3         // 连续发布失败达到该次数视为云端链路断开
 #define MOTOR_PERIOD_US 20000
 #define MOTOR_IDLE_SLEEP_US 50000
+#define DHT11_RETRY_MS 100
+#define NET_IFNAME "wlan0"
+#define NET_IP_TIMEOUT_MS 10000
+#define NET_POLL_MS 50
+#define FIRST_SAMPLE_TIMEOUT_MS 3000
+#define BOOT_REPORT_TIMEOUT_MS 30000
+#define SUP_LOCK_TIMEOUT_MS 50
+#define SUP_HEAP_CHECK_MS 10000     // 运行期堆水位检查周期
+#define OLED_LINE_COUNT 4
+#define OLED_LINE_LEN 24
+#define TRACE_RESP_TAIL_MAX 96      // get_trace 回执中数据之后的序号字段与结尾
+
+#define REBOOT_MARKER_KEY "sl_reboot"  // 主动热重启前写入 flash 的重启原因
+#define REBOOT_MARKER_LEN 32
+
+#ifdef SMART_LAUNDRY_RETAINED_RAM
+// 热重启保留区所在段由 src/smart_laundry_noinit.ld 定义（NOLOAD，启动代码不清零）；
+// 链接脚本未并入该片段时以下符号未定义，链接失败
+#define SL_NOINIT __attribute__((section(".sl_noinit")))
+extern char __sl_noinit_start[];
+extern char __sl_noinit_end[];
+#else
+#define SL_NOINIT
+#endif
+
+// 启动阶段事件：各任务就绪后置位，依赖方等待事件而非固定延时
+#define BOOT_EVT_OLED (1U << 0)
+#define BOOT_EVT_SENSOR (1U << 1)
+#define BOOT_EVT_NET (1U << 2)
+#define BOOT_EVT_REPORT (1U << 3)
 
 typedef enum {
-    DRY_MODE_FAST = 0,
-    DRY_MODE_STANDARD,
-    DRY_MODE_SOFT,
-    DRY_MODE_MAX
-} dry_mode_t;
-
-typedef struct {
-    int running;
-    dry_mode_t mode;
-    uint8_t humidity;
-    uint8_t temperature;
-    int countdown;
-} dryer_state_t;
+    BOOT_PHASE_INIT = 0,     // SYS_RUN 入口
+    BOOT_PHASE_TASKS,        // 本地任务创建完成
+    BOOT_PHASE_OLED,         // OLED 初始化完成
+    BOOT_PHASE_SENSOR,       // 首次 DHT11 采样成功
+    BOOT_PHASE_WIFI,         // Wi-Fi 连接并获取到 IP
+    BOOT_PHASE_MQTT,         // MQTT 连接、鉴权、订阅完成
+    BOOT_PHASE_REPORT,       // 首次属性上报
+    BOOT_PHASE_MAX
+} boot_phase_t;
 
 typedef struct {
     uint8_t temp;
@@ -70,10 +116,19 @@ typedef struct {
     dry_mode_t mode;
 } sensor_msg_t;
 
+_Static_assert(sizeof(sensor_msg_t) <= SENSOR_MSG_MAX_SIZE, "SENSOR_MSG_MAX_SIZE too small for sensor_msg_t");
+
 static dryer_state_t g_state = {0};
+static cycle_acct_t g_cycle;                // 烘干周期核算，受 g_state_lock 保护
 static osMutexId_t g_state_lock;
 static osMessageQueueId_t g_sensor_queue;   // OLED 刷新用的采样消息队列
 static osSemaphoreId_t g_oled_sem;          // 通知 OLED 有新数据
+static osEventFlagsId_t g_boot_events;      // 启动阶段就绪事件
+static uint32_t g_boot_ms[BOOT_PHASE_MAX];  // 各启动阶段完成时刻（上电起 ms），0 表示未完成
+static uint32_t g_heap_init_used;            // SYS_RUN 入口时的系统堆用量
+static uint32_t g_heap_boot_peak;            // 启动完成时的系统堆峰值，0 表示尚未完成启动
+static uint32_t g_heap_peak;                 // 已报告的最高堆峰值
+static uint32_t g_heap_growths;              // 启动后堆峰值升高次数
 
 static osThreadId_t g_control_task_id;
 static osThreadId_t g_motor_task_id;
@@ -81,26 +136,369 @@ static osThreadId_t g_key_task_id;
 static osThreadId_t g_oled_task_id;
 static osThreadId_t g_mqtt_send_task_id;
 static osThreadId_t g_mqtt_recv_task_id;
+static osThreadId_t g_net_task_id;
+static osThreadId_t g_sup_task_id;
+
+static supervisor_t g_sup;                      // 任务心跳监管表
+static volatile int g_motor_inhibit;            // 监管发现异常时禁止电机输出
+static sup_retained_t g_retained SL_NOINIT;     // 热重启保留现场
+static sup_reset_reason_t g_reset_reason = SUP_RESET_POWER_ON;
+static char g_reset_task[SUP_NAME_LEN];
+static uint32_t g_warm_boots;
+static uint8_t g_safe_stop;                     // 连续热重启超限，本次按停机状态恢复
+static uint8_t g_retained_lost;                 // 主动热重启后保留区失效：保留段未生效
+static volatile uint8_t g_task_stop[SUP_TASK_COUNT];  // 监管请求任务在心跳点退出
+static volatile uint8_t g_pub_failures;         // 连续发布失败次数，任一次成功清零
+#ifdef SMART_LAUNDRY_FAULT_INJECT
+static volatile uint32_t g_inject_hang_mask;    // 故障注入：置位的任务停止心跳
+static volatile uint32_t g_inject_hard_mask;    // 故障注入：置位的任务同时忽略退出请求
+static volatile uint32_t g_inject_at_ms[SUP_TASK_COUNT];  // 故障注入时刻，0 表示未注入或已检出
+static int inject_hang(const char *task, int hard);
+#endif
 
 static const uint8_t g_mode_duty[DRY_MODE_MAX] = {85, 65, 45};
+static const char *const g_boot_phase_name[BOOT_PHASE_MAX] = {
+    "init", "tasks", "oled", "sensor", "wifi", "mqtt", "report"
+};
+static char g_publish_topic[MQTT_TOPIC_BUF_SIZE];     // 属性上报主题缓冲区（仅 mqtt_send_task 使用）
+static char g_report_payload[MQTT_PAYLOAD_BUF_SIZE];  // 属性上报载荷缓冲区（仅 mqtt_send_task 使用）
+static char g_cmd_resp[CMD_RESP_BUF_SIZE];            // 带数据的命令回执缓冲区（仅 mqtt_recv_task 使用）
+static char g_event_payload[EVENT_PAYLOAD_BUF_SIZE];  // 周期汇总事件缓冲区（仅 mqtt_send_task 使用）
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+// 静态内存模式：按 smart_laundry_mem.h 的尺寸表预分配全部内核对象与任务栈
+#define SL_STATIC_TASK(name, stack)                        \
+    SL_CB_ARRAY(g_##name##_cb, SL_THREAD_CB_SIZE);         \
+    SL_STACK_ARRAY(g_##name##_stack, stack)
+#define TASK_MEM(name) SL_CB_MEM(g_##name##_cb), SL_STACK_MEM(g_##name##_stack)
+#define TASK_CB_SIZE SL_THREAD_CB_SIZE
+
+SL_STATIC_TASK(ctrl, TASK_STACK_CTRL);
+SL_STATIC_TASK(motor, TASK_STACK_MOTOR);
+SL_STATIC_TASK(keys, TASK_STACK_KEYS);
+SL_STATIC_TASK(oled, TASK_STACK_OLED);
+SL_STATIC_TASK(net, TASK_STACK_NET);
+SL_STATIC_TASK(mqtt_send, TASK_STACK_MQTT_SEND);
+SL_STATIC_TASK(mqtt_recv, TASK_STACK_MQTT_RECV);
+SL_STATIC_TASK(sup, TASK_STACK_SUP);
+
+SL_CB_ARRAY(g_state_lock_cb, SL_MUTEX_CB_SIZE);
+SL_CB_ARRAY(g_oled_sem_cb, SL_SEM_CB_SIZE);
+SL_CB_ARRAY(g_boot_events_cb, SL_EVENT_CB_SIZE);
+SL_CB_ARRAY(g_sensor_queue_cb, SL_MQ_CB_SIZE);
+SL_MQ_ARRAY(g_sensor_queue_mem, SL_QUEUE_SIZE);
+
+static const osMutexAttr_t g_state_lock_attr = {
+    .name = "state", .cb_mem = SL_CB_MEM(g_state_lock_cb), .cb_size = SL_CB_BYTES(g_state_lock_cb)
+};
+static const osSemaphoreAttr_t g_oled_sem_attr = {
+    .name = "oled", .cb_mem = SL_CB_MEM(g_oled_sem_cb), .cb_size = SL_CB_BYTES(g_oled_sem_cb)
+};
+static const osEventFlagsAttr_t g_boot_events_attr = {
+    .name = "boot", .cb_mem = SL_CB_MEM(g_boot_events_cb), .cb_size = SL_CB_BYTES(g_boot_events_cb)
+};
+static const osMessageQueueAttr_t g_sensor_queue_attr = {
+    .name = "sensor", .cb_mem = SL_CB_MEM(g_sensor_queue_cb), .cb_size = SL_CB_BYTES(g_sensor_queue_cb),
+    .mq_mem = SL_MQ_MEM(g_sensor_queue_mem), .mq_size = SL_MQ_BYTES(g_sensor_queue_mem)
+};
+#define OBJ_ATTR(name) (&g_##name##_attr)
+#define OBJ_CHECK(name, handle) static_cb_check(#name, (handle), SL_CB_MEM(g_##name##_cb), SL_CB_BYTES(g_##name##_cb))
+#define STACK_CHECK(mem, name) static_stack_check((name), SL_STACK_MEM(g_##mem##_stack), SL_STACK_BYTES(g_##mem##_stack))
+#define MQ_CHECK(name, heap_before, msg_bytes) static_mq_check(#name, SL_MQ_MEM(g_##name##_mem), (heap_before), (msg_bytes))
+
+static volatile uint32_t g_static_misplaced;   // 未落在传入静态内存中的内核对象与任务栈数
+
+// cJSON 解析池：下行命令解析期间顺序分配，全部释放后整体回收
+static uint64_t g_json_pool[JSON_POOL_SIZE / sizeof(uint64_t)];
+static size_t g_json_pool_used;
+static size_t g_json_pool_peak;
+static uint32_t g_json_live;
+static uint32_t g_json_overflows;    // 解析池不足次数，非零说明 JSON_POOL_SIZE 偏小
+
+// 运行状态、周期核算、监管表、保留现场与启动时刻表同样常驻 SRAM，与尺寸表一并计入预算；
+// 链接后各源文件全部静态变量的实际占用由 tools/ram_report.py 按符号表核对
+#define SL_APP_STATE_TOTAL (sizeof(g_state) + sizeof(g_cycle) + sizeof(g_sup) + sizeof(g_retained) + \
+                            sizeof(g_boot_ms))
+_Static_assert(SL_RAM_TOTAL + SL_APP_STATE_TOTAL <= SL_RAM_BUDGET,
+               "smart_laundry static memory map exceeds SL_RAM_BUDGET");
+#else
+#define TASK_MEM(name) NULL, NULL
+#define TASK_CB_SIZE 0U
+#define OBJ_ATTR(name) NULL
+#define OBJ_CHECK(name, handle) ((void)(handle))
+#define STACK_CHECK(mem, name) ((void)0)
+#define MQ_CHECK(name, heap_before, msg_bytes) ((void)(heap_before))
+#endif
+
 
 /**
- * @brief 将烘干模式枚举转换为人类可读的字符串
- * @param mode 烘干模式枚举值
- * @return 对应的模式字符串
+ * @brief 获取上电以来的毫秒数
+ * @return 毫秒时间戳，精度取决于系统 tick
+ */
+static uint32_t uptime_ms(void)
+{
+    uint32_t freq = osKernelGetTickFreq();
+    if (freq == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)osKernelGetTickCount() * 1000U) / freq);
+}
+
+/**
+ * @brief 记录启动阶段完成时刻并置位对应事件
+ * @param phase 启动阶段
+ * @param evt 需要置位的事件标志，0 表示仅记录时间
+ *
+ * 每个阶段只记录第一次完成的时刻
+ */
+static void boot_mark(boot_phase_t phase, uint32_t evt)
+{
+    if (phase < BOOT_PHASE_MAX && g_boot_ms[phase] == 0) {
+        uint32_t now = uptime_ms();
+        g_boot_ms[phase] = now ? now : 1;  // 0 保留为“未完成”
+    }
+    if (evt != 0 && g_boot_events != NULL) {
+        (void)osEventFlagsSet(g_boot_events, evt);
+    }
+}
+
+/**
+ * @brief 等待启动事件
+ * @param evt 等待的事件标志（全部满足）
+ * @param timeout_ms 超时时间（毫秒）
+ * @return 事件全部到达返回0，超时或不可用返回-1
+ */
+static int boot_wait(uint32_t evt, uint32_t timeout_ms)
+{
+    if (g_boot_events == NULL) {
+        return -1;
+    }
+    uint32_t ticks = (uint32_t)(((uint64_t)timeout_ms * osKernelGetTickFreq()) / 1000U);
+    uint32_t flags = osEventFlagsWait(g_boot_events, evt, osFlagsWaitAll | osFlagsNoClear, ticks ? ticks : 1);
+    if ((flags & osFlagsError) != 0 || (flags & evt) != evt) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 打印启动耗时分解
+ *
+ * 每行输出阶段完成时刻（上电起）及与上一已完成阶段的间隔，未完成阶段显示 "--"
+ */
+static void boot_report(void)
+{
+    uint32_t prev = 0;
+
+    printf("[boot] phase      at(ms)  delta(ms)\r\n");
+    for (int i = 0; i < BOOT_PHASE_MAX; i++) {
+        if (g_boot_ms[i] == 0) {
+            printf("[boot] %-8s       --         --\r\n", g_boot_phase_name[i]);
+            continue;
+        }
+        printf("[boot] %-8s %8u   %8u\r\n", g_boot_phase_name[i], (unsigned int)g_boot_ms[i],
+               (unsigned int)(g_boot_ms[i] >= prev ? g_boot_ms[i] - prev : 0));
+        if (g_boot_ms[i] > prev) {
+            prev = g_boot_ms[i];
+        }
+    }
+}
+
+/**
+ * @brief 读取系统堆用量
+ * @param info 输出堆信息
+ * @return 成功返回0，失败返回-1
  */
-static const char *mode_to_string(dry_mode_t mode)
+static int heap_sample(hi_mdm_mem_info *info)
 {
-    switch (mode) {
-        case DRY_MODE_FAST:
-            return "Fast";        // 快速烘干模式
-        case DRY_MODE_STANDARD:
-            return "Standard";   // 标准烘干模式
-        case DRY_MODE_SOFT:
-            return "Soft";        // 温柔烘干模式
-        default:
-            return "Standard";   // 默认标准模式
+    return hi_mem_get_sys_info(info) == 0 ? 0 : -1;
+}
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+/**
+ * @brief 校验内核对象句柄是否落在传入的静态控制块内
+ * @param name 对象名称
+ * @param handle 内核返回的句柄
+ * @param mem 传入的静态控制块
+ * @param size 控制块大小
+ *
+ * CMSIS 适配层可以忽略 cb_mem 而从内核对象池或堆分配，此时预留的数组白占 SRAM
+ */
+static void static_cb_check(const char *name, const void *handle, const void *mem, size_t size)
+{
+    if (!sl_static_mem_inside(handle, mem, size)) {
+        g_static_misplaced++;
+        printf("[mem] %s: kernel ignored cb_mem (handle %p), build with SL_KERNEL_CB_MEM=0\r\n", name, handle);
+    }
+}
+
+/**
+ * @brief 校验当前任务是否运行在传入的静态栈上，在任务入口调用
+ * @param name 任务名称
+ * @param stack 传入的静态栈
+ * @param size 栈大小
+ */
+static void static_stack_check(const char *name, const void *stack, size_t size)
+{
+    uint8_t marker = 0;
+
+    if (!sl_static_mem_inside(&marker, stack, size)) {
+        g_static_misplaced++;
+        printf("[mem] %s: kernel ignored stack_mem (sp near %p), build with SL_KERNEL_STACK_MEM=0\r\n", name,
+               (void *)&marker);
+    }
+}
+
+/**
+ * @brief 校验队列是否使用了传入的静态消息缓冲区，在创建队列后调用
+ * @param name 队列名称
+ * @param mq_mem 传入的消息缓冲区，NULL 表示未传入
+ * @param heap_before 创建前的堆已用字节数，0 表示未取得
+ * @param msg_bytes 队列消息总字节数
+ *
+ * 队列句柄不暴露缓冲区地址，改以堆用量判断：创建前后堆增长不少于消息总量，说明缓冲区来自内核堆
+ */
+static void static_mq_check(const char *name, const void *mq_mem, uint32_t heap_before, uint32_t msg_bytes)
+{
+    hi_mdm_mem_info info;
+
+    if (mq_mem == NULL || heap_before == 0 || heap_sample(&info) != 0) {
+        return;
     }
+    if (info.used >= heap_before + msg_bytes) {
+        g_static_misplaced++;
+        printf("[mem] %s: kernel ignored mq_mem (heap +%u), build with SL_KERNEL_MQ_MEM=0\r\n", name,
+               (unsigned int)(info.used - heap_before));
+    }
+}
+#endif
+
+/**
+ * @brief 任务心跳，各受监管任务在每次循环开始时调用
+ * @param id 任务ID
+ *
+ * 心跳点位于循环开头，此时任务不持有状态锁与追踪锁；监管请求退出时任务在此处自行结束
+ */
+static void task_heartbeat(sup_task_id_t id)
+{
+#ifdef SMART_LAUNDRY_FAULT_INJECT
+    // 故障注入：停止心跳模拟任务卡死；软卡死仍响应退出请求，硬卡死只能由热重启恢复
+    while (g_inject_hang_mask & (1U << id)) {
+        if (g_task_stop[id] && !(g_inject_hard_mask & (1U << id))) {
+            break;
+        }
+        usleep(10 * 1000);
+    }
+#endif
+    if (g_task_stop[id]) {
+        osThreadExit();
+    }
+    sup_beat(&g_sup, id, uptime_ms());
+}
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+/**
+ * @brief cJSON 静态解析池分配函数
+ * @param size 申请字节数
+ * @return 池内地址，池空间不足返回NULL（解析失败，命令回执 result_code=1）
+ *
+ * cJSON 仅在 mqtt_recv_task 上下文中使用，无需加锁
+ */
+static void *json_pool_malloc(size_t size)
+{
+    size = (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+    if (size > sizeof(g_json_pool) - g_json_pool_used) {
+        g_json_overflows++;
+        printf("[mem] json pool overflow (%u bytes requested, %u used)\r\n",
+               (unsigned int)size, (unsigned int)g_json_pool_used);
+        return NULL;
+    }
+    void *ptr = (uint8_t *)g_json_pool + g_json_pool_used;
+    g_json_pool_used += size;
+    if (g_json_pool_used > g_json_pool_peak) {
+        g_json_pool_peak = g_json_pool_used;
+    }
+    g_json_live++;
+    return ptr;
+}
+
+/**
+ * @brief cJSON 静态解析池释放函数
+ * @param ptr 待释放地址
+ *
+ * 顺序分配不单独回收，全部对象释放后整体复位
+ */
+static void json_pool_free(void *ptr)
+{
+    if (ptr == NULL || g_json_live == 0) {
+        return;
+    }
+    if (--g_json_live == 0) {
+        g_json_pool_used = 0;
+    }
+}
+#endif
+
+/**
+ * @brief 运行期堆水位检查，由监管任务周期调用
+ *
+ * 以启动完成时的堆峰值为基线：之后峰值再升高，说明运行期有代码路径（本应用、BSP 或协议栈）
+ * 申请了比启动阶段更多的堆，打印增量后以新峰值为基线继续监测，每次升高只报告一次
+ */
+static void heap_check(void)
+{
+    hi_mdm_mem_info info;
+
+    if (g_heap_boot_peak == 0 || heap_sample(&info) != 0 || info.peek_size <= g_heap_peak) {
+        return;
+    }
+    g_heap_growths++;
+    printf("[mem] heap grew after boot (#%u): peak=%u (+%u since boot) used=%u largest_free=%u fails=%u\r\n",
+           (unsigned int)g_heap_growths, (unsigned int)info.peek_size,
+           (unsigned int)(info.peek_size - g_heap_boot_peak), (unsigned int)info.used,
+           (unsigned int)info.max_free_node_size, (unsigned int)info.malloc_fail_count);
+    g_heap_peak = info.peek_size;
+}
+
+/**
+ * @brief 打印内存布局与使用情况
+ *
+ * 静态内存模式下输出各区域的编译期尺寸、预算余量与 JSON 解析池峰值；
+ * 默认模式下任务栈与内核对象来自内核堆，仅提示当前模式。
+ * 两种模式均记录启动完成时的堆峰值，作为 heap_check 的基线
+ */
+static void mem_report(void)
+{
+    hi_mdm_mem_info info;
+
+    if (heap_sample(&info) == 0) {
+        g_heap_boot_peak = info.peek_size ? info.peek_size : 1;
+        g_heap_peak = g_heap_boot_peak;
+        printf("[mem] heap: init used=%u, boot used=%u peak=%u total=%u fails=%u\r\n",
+               (unsigned int)g_heap_init_used, (unsigned int)info.used, (unsigned int)info.peek_size,
+               (unsigned int)info.total, (unsigned int)info.malloc_fail_count);
+    }
+#ifdef SMART_LAUNDRY_STATIC_MEM
+    printf("[mem] static: stacks=%u cb=%u queue=%u buffers=%u state=%u total=%u budget=%u free=%u\r\n",
+           (unsigned int)SL_STACK_TOTAL, (unsigned int)SL_CB_TOTAL, (unsigned int)SL_QUEUE_TOTAL,
+           (unsigned int)SL_BUFFER_TOTAL, (unsigned int)SL_APP_STATE_TOTAL,
+           (unsigned int)(SL_RAM_TOTAL + SL_APP_STATE_TOTAL), (unsigned int)SL_RAM_BUDGET,
+           (unsigned int)(SL_RAM_BUDGET - SL_RAM_TOTAL - SL_APP_STATE_TOTAL));
+    printf("[mem] json pool peak=%u/%u overflows=%u\r\n",
+           (unsigned int)g_json_pool_peak, (unsigned int)sizeof(g_json_pool), (unsigned int)g_json_overflows);
+    if (SL_KHEAP_TOTAL != 0) {
+        printf("[mem] kernel heap: stacks=%u queue=%u (SL_KERNEL_STACK_MEM=%d SL_KERNEL_MQ_MEM=%d)\r\n",
+               (unsigned int)(SL_STACK_SIZES - SL_STACK_TOTAL), (unsigned int)(SL_QUEUE_SIZE - SL_QUEUE_TOTAL),
+               SL_KERNEL_STACK_MEM, SL_KERNEL_MQ_MEM);
+    }
+    if (g_static_misplaced != 0) {
+        // 适配层忽略了传入的静态内存：这些对象实际来自内核，静态数组白占 SRAM 且计入了预算
+        printf("[mem] %u kernel objects/stacks/queues outside the static arrays, rebuild with the "
+               "SL_KERNEL_*_MEM=0 named above\r\n", (unsigned int)g_static_misplaced);
+    }
+#else
+    printf("[mem] dynamic: stacks=%u from kernel heap\r\n", (unsigned int)SL_STACK_SIZES);
+#endif
 }
 
 /**
@@ -167,19 +565,47 @@ static void set_mode(dry_mode_t mode)
 }
 
 /**
- * @brief 更新传感器温湿度值
- * @param temp 温度值
- * @param hum 湿度值
+ * @brief 打印一个已结束烘干周期的汇总
+ * @param summary 周期汇总
+ */
+static void log_cycle(const cycle_summary_t *summary)
+{
+    printf("[cycle] #%u %s->%s %s %us motor=%us hum %u->%u\r\n", (unsigned int)summary->seq,
+           cycle_reason_to_string((cycle_reason_t)summary->start_reason),
+           cycle_reason_to_string((cycle_reason_t)summary->stop_reason),
+           mode_to_string((dry_mode_t)summary->mode), (unsigned int)(summary->duration_ms / 1000U),
+           (unsigned int)(summary->motor_on_ms / 1000U), (unsigned int)summary->hum_start,
+           (unsigned int)summary->hum_end);
+}
+
+/**
+ * @brief 应用按键或云端输入并提交状态
+ * @param source 输入来源（TRACE_EVT_KEY / TRACE_EVT_CLOUD）
+ * @param input 输入类型
+ * @param arg 输入参数
+ * @return 提交后的状态快照
  *
- * 从DHT11传感器读取数据后更新到全局状态
+ * 输入记录、状态变更、状态提交记录与周期核算在同一临界区内完成，保证追踪顺序与实际执行顺序一致
  */
-static void update_sensor_values(uint8_t temp, uint8_t hum)
+static dryer_state_t apply_input(trace_evt_t source, dryer_input_t input, int arg)
 {
-    // 加锁保护全局状态，确保设置操作的安全性
+    dryer_state_t snapshot;
+    cycle_summary_t summary;
+    cycle_reason_t reason = source == TRACE_EVT_KEY ? CYCLE_REASON_KEY : CYCLE_REASON_CLOUD;
+
     osMutexAcquire(g_state_lock, osWaitForever);
-    g_state.temperature = temp;   // 更新温度值
-    g_state.humidity = hum;       // 更新湿度值
+    dryer_trace_record(source, (uint8_t)input, (int16_t)arg);
+    dryer_apply_input(&g_state, input, arg);
+    dryer_trace_state(&g_state);
+    int closed = dryer_cycle_update(&g_cycle, &g_state, reason, uptime_ms(), &summary);
+    snapshot = g_state;
     osMutexRelease(g_state_lock);
+    // 同步控制LED指示灯状态
+    LED(snapshot.running ? 1 : 0);
+    if (closed) {
+        log_cycle(&summary);
+    }
+    return snapshot;
 }
 
 /**
@@ -238,6 +664,10 @@ static int parse_mode_from_json(const cJSON *paras, dry_mode_t *mode)
  * - stop: 停止烘干机
  * - toggle: 切换烘干机运行状态
  * - set_mode/switch_mode: 设置烘干模式，需要JSON参数
+ * - dump_trace: 将事件追踪记录打印到串口
+ * - inject_hang: 故障注入，指定任务停止心跳，hard 为真时不响应退出请求（仅 SMART_LAUNDRY_FAULT_INJECT 构建）
+ *
+ * get_trace 需要携带数据回执，由 mqtt_client_sub_callback 单独处理
  */
 static int apply_cloud_command(const char *command_name, const cJSON *paras)
 {
@@ -246,37 +676,70 @@ static int apply_cloud_command(const char *command_name, const cJSON *paras)
     }
 
     if (strcmp(command_name, "start") == 0) {
-        set_running(1);    // 启动烘干机
+        (void)apply_input(TRACE_EVT_CLOUD, DRYER_INPUT_START, 0);    // 启动烘干机
         return 0;
     }
     if (strcmp(command_name, "stop") == 0) {
-        set_running(0);    // 停止烘干机
+        (void)apply_input(TRACE_EVT_CLOUD, DRYER_INPUT_STOP, 0);     // 停止烘干机
         return 0;
     }
     if (strcmp(command_name, "toggle") == 0) {
-        dryer_state_t state = get_state_snapshot();
-        set_running(!state.running);  // 切换运行状态
+        (void)apply_input(TRACE_EVT_CLOUD, DRYER_INPUT_TOGGLE, 0);   // 切换运行状态
         return 0;
     }
     if (strcmp(command_name, "set_mode") == 0 || strcmp(command_name, "switch_mode") == 0) {
         dry_mode_t mode = DRY_MODE_STANDARD;
         if (parse_mode_from_json(paras, &mode) == 0) {
-            set_mode(mode);  // 设置烘干模式
+            (void)apply_input(TRACE_EVT_CLOUD, DRYER_INPUT_SET_MODE, mode);  // 设置烘干模式
             return 0;
         }
     }
+    if (strcmp(command_name, "dump_trace") == 0) {
+        dryer_trace_dump();  // 追踪记录打印到串口
+        return 0;
+    }
+#ifdef SMART_LAUNDRY_FAULT_INJECT
+    if (strcmp(command_name, "inject_hang") == 0) {
+        const cJSON *task = cJSON_GetObjectItem(paras, "task");
+        const cJSON *hard = cJSON_GetObjectItem(paras, "hard");
+        int hard_hang = cJSON_IsTrue(hard) || (cJSON_IsNumber(hard) && hard->valueint != 0);
+        if (task != NULL && cJSON_IsString(task)) {
+            return inject_hang(task->valuestring, hard_hang) == 0 ? 0 : 1;  // 指定任务停止心跳
+        }
+    }
+#endif
 
     return 1;  // 不支持的命令
 }
 
+/**
+ * @brief 发布一条 MQTT 消息并统计连续失败次数
+ * @return 0 成功，-1 失败（BSP 返回发送字节数，负值为套接字错误）
+ *
+ * 对端无响应的断链上 MQTTClient_sub 一直阻塞，接收任务无法反映链路状态；
+ * 发送失败在 TCP 重传放弃后出现，由 mqtt_send_task 据连续失败次数判定链路断开
+ */
+static int mqtt_publish(char *topic, const char *payload)
+{
+    if (MQTTClient_pub(topic, (unsigned char *)payload, (int)strlen(payload)) < 0) {
+        if (g_pub_failures < UINT8_MAX) {
+            g_pub_failures++;
+        }
+        return -1;
+    }
+    g_pub_failures = 0;
+    return 0;
+}
+
 /**
  * @brief 向云端发送命令执行结果
  * @param request_id 请求ID
  * @param ret_code 执行结果码（0=成功，1=失败）
+ * @param body 完整回执JSON，NULL 时按 ret_code 回复 {"result_code":x}
  *
  * 响应云端指令的执行状态，用于命令响应机制
  */
-static void send_cloud_request_code(const char *request_id, int ret_code)
+static void send_cloud_response(const char *request_id, int ret_code, const char *body)
 {
     char request_topic[128] = {0};
     // 构建响应主题：$oc/devices/{DEVICE_ID}/sys/commands/response/request_id={request_id}
@@ -285,58 +748,81 @@ static void send_cloud_request_code(const char *request_id, int ret_code)
     }
 
     // 发送JSON格式的执行结果
-    if (ret_code == 0) {
-        MQTTClient_pub(request_topic, (unsigned char *)"{\"result_code\":0}", strlen("{\"result_code\":0}"));
+    if (body != NULL) {
+        (void)mqtt_publish(request_topic, body);
+    } else if (ret_code == 0) {
+        (void)mqtt_publish(request_topic, "{\"result_code\":0}");
     } else {
-        MQTTClient_pub(request_topic, (unsigned char *)"{\"result_code\":1}", strlen("{\"result_code\":1}"));
+        (void)mqtt_publish(request_topic, "{\"result_code\":1}");
     }
 }
 
 /**
- * @brief 包装设备属性数据为MQTT消息格式
+ * @brief 构建 get_trace 命令回执
+ * @param paras JSON参数对象，可选 {"seq": s, "count": m}
  * @param buffer 输出缓冲区
  * @param len 缓冲区长度
  * @return 成功返回0，失败返回-1
  *
- * 按照IoTDA规范构建属性上报消息，包含服务数组结构
+ * 回执格式：{"result_code":0,"response_name":"get_trace","paras":{"data":"<hex>","first":s,"next":n,"head":h,"lost":l,"count":m}}，
+ * 单次最多 TRACE_CHUNK_MAX 条。云端省略 seq 从最旧记录开始，之后以上次回执的 next 作为 seq 拉取直到 next == head；
+ * 分段按单调递增的记录序号定位，拉取期间新写入的记录不会造成重复或遗漏
  */
-static int package_properties_payload(char *buffer, size_t len)
+static int package_trace_response(const cJSON *paras, char *buffer, size_t len)
 {
-    dryer_state_t state = get_state_snapshot();
+    const cJSON *seq_node = cJSON_GetObjectItem(paras, "seq");
+    const cJSON *count_node = cJSON_GetObjectItem(paras, "count");
+    uint32_t seq = DRYER_TRACE_SEQ_OLDEST;
+    uint32_t count = TRACE_CHUNK_MAX;
+    dryer_trace_page_t page;
+
+    if (seq_node != NULL && cJSON_IsNumber(seq_node) && seq_node->valuedouble >= 0 &&
+        seq_node->valuedouble < (double)DRYER_TRACE_SEQ_OLDEST) {
+        seq = (uint32_t)seq_node->valuedouble;
+    }
+    if (count_node != NULL && cJSON_IsNumber(count_node) && count_node->valueint > 0 &&
+        count_node->valueint <= TRACE_CHUNK_MAX) {
+        count = (uint32_t)count_node->valueint;
+    }
 
-    // IoTDA 属性上报采用 services 数组格式
-    cJSON *root = cJSON_CreateObject();
-    if (root == NULL) {
+    int n = snprintf(buffer, len, "{\"result_code\":0,\"response_name\":\"get_trace\",\"paras\":{\"data\":\"");
+    if (n < 0 || (size_t)n + TRACE_RESP_TAIL_MAX >= len) {
         return -1;
     }
+    size_t pos = (size_t)n;
+    (void)dryer_trace_export_hex(seq, count, buffer + pos, len - pos - TRACE_RESP_TAIL_MAX, &page);
+    pos += strlen(buffer + pos);
+    n = snprintf(buffer + pos, len - pos, "\",\"first\":%u,\"next\":%u,\"head\":%u,\"lost\":%u,\"count\":%u}}",
+                 (unsigned int)page.first, (unsigned int)page.next, (unsigned int)page.head,
+                 (unsigned int)page.lost, (unsigned int)page.count);
+    if (n < 0 || (size_t)n >= len - pos) {
+        return -1;
+    }
+    return 0;
+}
 
-    cJSON *services = cJSON_CreateArray();
-    cJSON_AddItemToObject(root, "services", services);
-
-    cJSON *service = cJSON_CreateObject();
-    cJSON_AddItemToArray(services, service);
-    cJSON_AddStringToObject(service, "service_id", "dryer");  // 设备服务ID
-
-    cJSON *properties = cJSON_CreateObject();
-    cJSON_AddItemToObject(service, "properties", properties);
-
-    // 添加设备属性信息
-    cJSON_AddStringToObject(properties, "status", state.running ? "RUNNING" : "STOPPED");
-    cJSON_AddStringToObject(properties, "mode", mode_to_string(state.mode));
-    cJSON_AddNumberToObject(properties, "humidity", state.humidity);
-    cJSON_AddNumberToObject(properties, "temperature", state.temperature);
-    cJSON_AddNumberToObject(properties, "countdown", state.countdown);
+/**
+ * @brief 包装设备属性数据为MQTT消息格式
+ * @param buffer 输出缓冲区
+ * @param len 缓冲区长度
+ * @return 成功返回0，失败返回-1
+ *
+ * 按照IoTDA规范构建属性上报消息，包含服务数组结构；缓冲区不足时返回-1
+ */
+static int package_properties_payload(char *buffer, size_t len)
+{
+    dryer_state_t state = get_state_snapshot();
 
-    char *printed = cJSON_PrintUnformatted(root);
-    int ret = -1;
-    if (printed != NULL) {
-        if ((int)snprintf(buffer, len, "%s", printed) >= 0) {
-            ret = 0;
-        }
-        cJSON_free(printed);
+    // IoTDA 属性上报采用 services 数组格式；字段固定，直接格式化到调用方缓冲区，不经过堆
+    int n = snprintf(buffer, len,
+                     "{\"services\":[{\"service_id\":\"dryer\",\"properties\":{"
+                     "\"status\":\"%s\",\"mode\":\"%s\",\"humidity\":%u,\"temperature\":%u,\"countdown\":%d}}]}",
+                     state.running ? "RUNNING" : "STOPPED", mode_to_string(state.mode),
+                     (unsigned int)state.humidity, (unsigned int)state.temperature, state.countdown);
+    if (n < 0 || (size_t)n >= len) {
+        return -1;  // 缓冲区不足
     }
-    cJSON_Delete(root);
-    return ret;
+    return 0;
 }
 
 /**
@@ -359,11 +845,20 @@ static int8_t mqtt_client_sub_callback(unsigned char *topic, unsigned char *payl
     // 解析JSON消息
     cJSON *root = cJSON_Parse((const char *)payload);
     int ret_code = 1;
+    const char *resp_body = NULL;
     if (root != NULL) {
         cJSON *command_name = cJSON_GetObjectItem(root, "command_name");
         cJSON *paras = cJSON_GetObjectItem(root, "paras");
         if (command_name != NULL && cJSON_IsString(command_name)) {
-            ret_code = apply_cloud_command(command_name->valuestring, paras);  // 执行命令
+            if (strcmp(command_name->valuestring, "get_trace") == 0) {
+                // 追踪数据随回执返回
+                if (package_trace_response(paras, g_cmd_resp, sizeof(g_cmd_resp)) == 0) {
+                    ret_code = 0;
+                    resp_body = g_cmd_resp;
+                }
+            } else {
+                ret_code = apply_cloud_command(command_name->valuestring, paras);  // 执行命令
+            }
         }
         cJSON_Delete(root);
     }
@@ -375,33 +870,106 @@ static int8_t mqtt_client_sub_callback(unsigned char *topic, unsigned char *payl
         char request_id[64] = {0};
         pos += strlen(request_key);
         snprintf(request_id, sizeof(request_id), "%s", pos);
-        send_cloud_request_code(request_id, ret_code);  // 发送执行结果
+        send_cloud_response(request_id, ret_code, resp_body);  // 发送执行结果
     }
 
     return 0;
 }
 
+/**
+ * @brief 上报待发送的烘干周期汇总事件
+ *
+ * 每个已结束周期上报一条 cycle_summary 事件到 $oc/devices/{DEVICE_ID}/sys/events/up，
+ * 携带周期序号、启停原因、时长、电机导通时间、起止湿度与设备端时长直方图。
+ * 发布成功后才移出队列，失败的汇总留待下一轮上报重发
+ */
+static void publish_cycle_events(void)
+{
+    cycle_summary_t summary;
+    uint32_t hist[CYCLE_HIST_BUCKETS];
+
+    if (snprintf(g_publish_topic, sizeof(g_publish_topic), MQTT_TOPIC_PUB_EVENTS, DEVICE_ID) <= 0) {
+        return;
+    }
+    while (1) {
+        osMutexAcquire(g_state_lock, osWaitForever);
+        int ret = dryer_cycle_peek(&g_cycle, &summary);
+        memcpy(hist, g_cycle.hist, sizeof(hist));
+        osMutexRelease(g_state_lock);
+        if (ret != 0) {
+            break;
+        }
+        if (dryer_cycle_format_event(&summary, hist, uptime_ms(), g_event_payload, sizeof(g_event_payload)) != 0) {
+            printf("[cycle] #%u summary does not fit the event buffer, dropped\r\n", (unsigned int)summary.seq);
+        } else if (mqtt_publish(g_publish_topic, g_event_payload) != 0) {
+            break;
+        }
+        osMutexAcquire(g_state_lock, osWaitForever);
+        dryer_cycle_ack(&g_cycle, summary.seq);
+        osMutexRelease(g_state_lock);
+    }
+}
+
+/**
+ * @brief 上报本次启动的重启原因
+ *
+ * 连上云端后上报一条 reset_report 事件：重启原因、引发热重启的任务与连续热重启次数
+ */
+static void publish_reset_report(void)
+{
+    if (snprintf(g_publish_topic, sizeof(g_publish_topic), MQTT_TOPIC_PUB_EVENTS, DEVICE_ID) <= 0) {
+        return;
+    }
+    int n = snprintf(g_event_payload, sizeof(g_event_payload),
+                     "{\"services\":[{\"service_id\":\"dryer\",\"event_type\":\"reset_report\",\"paras\":{"
+                     "\"reason\":\"%s\",\"task\":\"%s\",\"warm_boots\":%u,\"retained_lost\":%u,"
+                     "\"safe_stop\":%u}}]}",
+                     sup_reset_reason_to_string(g_reset_reason), g_reset_task, (unsigned int)g_warm_boots,
+                     (unsigned int)g_retained_lost, (unsigned int)g_safe_stop);
+    if (n > 0 && (size_t)n < sizeof(g_event_payload)) {
+        (void)mqtt_publish(g_publish_topic, g_event_payload);
+    }
+}
+
 /**
  * @brief MQTT消息发送任务
  * @param arg 任务参数（未使用）
  *
- * 定期向云端上报设备属性数据，包含状态、模式、温湿度等信息
+ * 连上云端后先上报重启原因，之后定期上报设备属性数据，包含状态、模式、温湿度等信息，以及已结束周期的汇总事件。
+ * 连续 MQTT_PUB_FAIL_MAX 次发布失败后停止心跳，由监管按本任务超时热重启并重新接入；期间一次发布成功即恢复心跳
  */
 static void mqtt_send_task(void *arg)
 {
     (void)arg;
-    char publish_topic[128] = {0};
-    char payload[256] = {0};
+    STACK_CHECK(mqtt_send, "mqtt_send");
+    int first = 1;
+    int link_down = 0;
+
+    // 首次上报等待第一帧有效采样，避免上报全零数据；传感器异常时超时后照常上报
+    (void)boot_wait(BOOT_EVT_SENSOR, FIRST_SAMPLE_TIMEOUT_MS);
+
+    publish_reset_report();
 
     while (1) {
-        memset(publish_topic, 0, sizeof(publish_topic));
-        memset(payload, 0, sizeof(payload));
+        if (g_pub_failures < MQTT_PUB_FAIL_MAX) {
+            task_heartbeat(SUP_TASK_MQTT_SEND);
+            link_down = 0;
+        } else if (!link_down) {
+            printf("[mqtt] %u consecutive publish failures, link down\r\n", (unsigned int)g_pub_failures);
+            link_down = 1;
+        }
+        memset(g_publish_topic, 0, sizeof(g_publish_topic));
+        memset(g_report_payload, 0, sizeof(g_report_payload));
 
         // 构建属性上报主题：$oc/devices/{DEVICE_ID}/sys/properties/report
-        if (snprintf(publish_topic, sizeof(publish_topic), MQTT_TOPIC_PUB_PROPERTIES, DEVICE_ID) > 0 &&
-            package_properties_payload(payload, sizeof(payload)) == 0) {
-            MQTTClient_pub(publish_topic, (unsigned char *)payload, strlen(payload));
+        if (snprintf(g_publish_topic, sizeof(g_publish_topic), MQTT_TOPIC_PUB_PROPERTIES, DEVICE_ID) > 0 &&
+            package_properties_payload(g_report_payload, sizeof(g_report_payload)) == 0) {
+            if (mqtt_publish(g_publish_topic, g_report_payload) == 0 && first) {
+                boot_mark(BOOT_PHASE_REPORT, BOOT_EVT_REPORT);
+                first = 0;
+            }
         }
+        publish_cycle_events();
         sleep(MQTT_SEND_INTERVAL_SEC);  // 3秒间隔上报
     }
 }
@@ -415,42 +983,69 @@ static void mqtt_send_task(void *arg)
 static void mqtt_recv_task(void *arg)
 {
     (void)arg;
+    STACK_CHECK(mqtt_recv, "mqtt_recv");
     while (1) {
+        task_heartbeat(SUP_TASK_MQTT_RECV);
         MQTTClient_sub();  // 阻塞式订阅消息，等待云端指令
         sleep(1);
     }
 }
 
+/**
+ * @brief 等待Wi-Fi网卡获取到IP地址
+ * @param timeout_ms 超时时间（毫秒）
+ * @return 获取到IP返回0，超时返回-1
+ *
+ * 以短周期轮询 DHCP 结果代替固定延时，IP 就绪即返回
+ */
+static int wait_for_ip(uint32_t timeout_ms)
+{
+    uint32_t start = uptime_ms();
+
+    do {
+        struct netif *netif = netifapi_netif_find(NET_IFNAME);
+        if (netif != NULL && !ip4_addr_isany(netif_ip4_addr(netif))) {
+            return 0;
+        }
+        osDelay((NET_POLL_MS * osKernelGetTickFreq()) / 1000U + 1U);
+    } while (uptime_ms() - start < timeout_ms);
+
+    return -1;
+}
+
 /**
  * @brief Wi-Fi和MQTT初始化函数
  * @return 0表示成功，-1表示失败
  *
- * 完成Wi-Fi连接、MQTT服务器连接、客户端初始化和指令订阅
+ * 完成Wi-Fi连接、MQTT服务器连接、客户端初始化和指令订阅。
+ * 各步骤均为同步调用，仅在 DHCP 处等待实际就绪，不做固定延时
  */
 static int wifi_mqtt_init(void)
 {
     char sub_topic[128] = {0};
 
-    // 1. Wi-Fi 连接到指定网络
+    // 1. Wi-Fi 连接到指定网络，并等待 DHCP 分配地址
     if (WiFi_connectHotspots(WIFI_SSID, WIFI_PAWD) != WIFI_SUCCESS) {
         printf("[wifi] connect failed\r\n");
         return -1;
     }
-    sleep(2);  // 等待连接稳定
+    if (wait_for_ip(NET_IP_TIMEOUT_MS) != 0) {
+        printf("[wifi] dhcp timeout\r\n");
+        return -1;
+    }
+    boot_mark(BOOT_PHASE_WIFI, 0);
 
-    // 2. 连接 MQTT 服务器
+    // 2. 连接 MQTT 服务器（TCP 建连完成即返回）
     if (MQTTClient_connectServer(SERVER_IP_ADDR, SERVER_IP_PORT) != WIFI_SUCCESS) {
         printf("[mqtt] connect server failed\r\n");
         return -1;
     }
-    sleep(1);
 
-    // 3. 初始化MQTT客户端身份（设备ID、用户名、密码）
+    // 3. 初始化MQTT客户端身份（设备ID、用户名、密码），收到 CONNACK 即返回
     if (MQTTClient_init(MQTT_CLIENT_ID, MQTT_USER_NAME, MQTT_PASS_WORD) != WIFI_SUCCESS) {
         printf("[mqtt] client init failed\r\n");
         return -1;
     }
-    sleep(1);
 
     // 4. 订阅云端下行指令主题
     if (snprintf(sub_topic, sizeof(sub_topic), MQTT_TOPIC_SUB_COMMANDS, DEVICE_ID) <= 0) {
@@ -463,9 +1058,38 @@ static int wifi_mqtt_init(void)
         printf("[mqtt] subscribe failed\r\n");
         return -1;
     }
+    boot_mark(BOOT_PHASE_MQTT, BOOT_EVT_NET);
     return 0;
 }
 
+/**
+ * @brief 处理一帧有效采样
+ * @param temp 温度
+ * @param hum 湿度
+ *
+ * 采样记录、倒计时判定、状态提交与周期核算在同一临界区内完成
+ */
+static void control_step(uint8_t temp, uint8_t hum)
+{
+    cycle_summary_t summary;
+
+    osMutexAcquire(g_state_lock, osWaitForever);
+    dryer_trace_record(TRACE_EVT_SENSOR, hum, temp);
+    int stopped = dryer_sensor_step(&g_state, temp, hum);
+    dryer_trace_state(&g_state);
+    int closed = dryer_cycle_update(&g_cycle, &g_state, CYCLE_REASON_HUMIDITY, uptime_ms(), &summary);
+    osMutexRelease(g_state_lock);
+
+    // 倒计时结束已停机，同步熄灭LED
+    if (stopped) {
+        printf("Humidity below threshold, stopping dryer\r\n");
+        LED(0);
+    }
+    if (closed) {
+        log_cycle(&summary);
+    }
+}
+
 /**
  * @brief 主控制任务
  * @param arg 任务参数（未使用）
@@ -475,49 +1099,30 @@ static int wifi_mqtt_init(void)
 static void control_task(void *arg)
 {
     (void)arg;
+    STACK_CHECK(ctrl, "dryer_ctrl");
     uint8_t temp = 0;
     uint8_t hum = 0;
 
-    // DHT11 初始化重试，确保传感器可用
+    // DHT11 初始化重试，确保传感器可用；与网络、OLED 初始化并行，短周期重试
     while (dht11_init() != 0) {
+        task_heartbeat(SUP_TASK_CTRL);
         printf("DHT11 init failed, retry...\r\n");
-        usleep(500 * 1000);
+        usleep(DHT11_RETRY_MS * 1000);
     }
     printf("DHT11 init success\r\n");
 
     // 周期采样 + 湿度判定 + 倒计时关机逻辑
     while (1) {
+        task_heartbeat(SUP_TASK_CTRL);
         // 读取DHT11传感器数据
         if (dht11_read_data(&temp, &hum) == 0) {
-            update_sensor_values(temp, hum);
+            boot_mark(BOOT_PHASE_SENSOR, BOOT_EVT_SENSOR);
             printf("Temp=%uC Humidity=%u%%\r\n", temp, hum);
 
             // 智能烘干控制逻辑
-            int should_stop = 0;
-            osMutexAcquire(g_state_lock, osWaitForever);
-            if (g_state.running) {
-                if (hum <= HUMIDITY_THRESHOLD) {  // 湿度达到阈值，开始倒计时
-                    if (g_state.countdown < 0) {
-                        g_state.countdown = COUNTDOWN_SECONDS;  // 开始10秒倒计时
-                    } else if (g_state.countdown > 0) {
-                        g_state.countdown -= 1;  // 倒计时递减
-                    } else {
-                        should_stop = 1;  // 倒计时结束，停止烘干
-                    }
-                } else {
-                    g_state.countdown = -1;  // 湿度未达标，重置倒计时
-                }
-            } else {
-                g_state.countdown = -1;  // 未运行时保持倒计时重置状态
-            }
-            osMutexRelease(g_state_lock);
-
-            // 执行停止烘干逻辑
-            if (should_stop) {
-                printf("Humidity below threshold, stopping dryer\r\n");
-                set_running(0);
-            }
+            control_step(temp, hum);
         } else {
+            dryer_trace_record(TRACE_EVT_SENSOR_FAIL, 0, 1);
             printf("DHT11 read failed\r\n");
         }
 
@@ -551,12 +1156,24 @@ static void control_task(void *arg)
 static void motor_task(void *arg)
 {
     (void)arg;
+    STACK_CHECK(motor, "motor_pwm");
+    int last_duty = -1;
     dc_motor_init();
 
     // 软件 PWM 实现电机速度控制，占空比按档位切换
     while (1) {
+        task_heartbeat(SUP_TASK_MOTOR);
         dryer_state_t state = get_state_snapshot();
-        if (state.running) {
+        int drive = state.running && !g_motor_inhibit;  // 监管异常期间保持电机关闭
+        int duty = drive ? g_mode_duty[state.mode] : 0;
+        if (duty != last_duty) {
+            dryer_trace_record(TRACE_EVT_DUTY, (uint8_t)duty, 0);  // 仅记录占空比变化
+            osMutexAcquire(g_state_lock, osWaitForever);
+            dryer_cycle_duty(&g_cycle, (uint8_t)duty, uptime_ms());  // 按占空比积分电机导通时间
+            osMutexRelease(g_state_lock);
+            last_duty = duty;
+        }
+        if (drive) {
             // 根据当前模式计算PWM占空比
             uint32_t on_time = (MOTOR_PERIOD_US * g_mode_duty[state.mode]) / 100;
             if (on_time > MOTOR_PERIOD_US) {
@@ -574,7 +1191,7 @@ static void motor_task(void *arg)
                 usleep(off_time);
             }
         } else {
-            DC_MOTOR(0);  // 未运行时关闭电机
+            DC_MOTOR(0);  // 未运行或监管异常时关闭电机
             usleep(MOTOR_IDLE_SLEEP_US);  // 延长空闲休眠时间
         }
     }
@@ -591,26 +1208,25 @@ static void motor_task(void *arg)
 static void key_task(void *arg)
 {
     (void)arg;
+    STACK_CHECK(keys, "keys");
     key_init();
 
     // KEY1 控制启停，KEY2 控制模式切换
     while (1) {
+        task_heartbeat(SUP_TASK_KEYS);
         uint8_t key = key_scan(0);
         if (key == KEY1_PRESS) {
             // KEY1：启停烘干机
-            dryer_state_t state = get_state_snapshot();
-            set_running(!state.running);  // 切换运行状态
-            printf("Key1 pressed, dryer %s\r\n", state.running ? "stop" : "start");
+            dryer_state_t state = apply_input(TRACE_EVT_KEY, DRYER_INPUT_TOGGLE, 0);  // 切换运行状态
+            printf("Key1 pressed, dryer %s\r\n", state.running ? "start" : "stop");
             if (g_oled_sem != NULL) {
                 (void)osSemaphoreRelease(g_oled_sem);  // 通知OLED刷新显示
             }
             usleep(300 * 1000);  // 按键去抖延时
         } else if (key == KEY2_PRESS) {
             // KEY2：循环切换烘干模式
-            dryer_state_t state = get_state_snapshot();
-            dry_mode_t next = (state.mode + 1) % DRY_MODE_MAX;  // 循环切换
-            set_mode(next);
-            printf("Key2 pressed, switch mode to %s\r\n", mode_to_string(next));
+            dryer_state_t state = apply_input(TRACE_EVT_KEY, DRYER_INPUT_NEXT_MODE, 0);  // 循环切换
+            printf("Key2 pressed, switch mode to %s\r\n", mode_to_string(state.mode));
             if (g_oled_sem != NULL) {
                 (void)osSemaphoreRelease(g_oled_sem);  // 通知OLED刷新显示
             }
@@ -622,8 +1238,9 @@ static void key_task(void *arg)
 }
 
 /**
- * @brief OLED显示任务
- * @param arg 任务参数（未使用）
+ * @brief 格式化OLED显示内容
+ * @param msg 最新采样与状态
+ * @param lines 输出的各行文本
  *
  * OLED显示格式：
  * 第1行：设备运行状态 (RUN/STOP)
@@ -631,13 +1248,29 @@ static void key_task(void *arg)
  * 第3行：温湿度显示 (H:xx% T:xx°C)
  * 第4行：剩余时间显示 (运行时显示倒计时)
  */
+static void oled_format_lines(const sensor_msg_t *msg, char lines[OLED_LINE_COUNT][OLED_LINE_LEN])
+{
+    snprintf(lines[0], OLED_LINE_LEN, "Dryer: %s", msg->running ? "RUN" : "STOP");
+    snprintf(lines[1], OLED_LINE_LEN, "Mode: %s", mode_to_string(msg->mode));
+    snprintf(lines[2], OLED_LINE_LEN, "H:%u%%  T:%uC", msg->hum, msg->temp);
+    if (msg->running && msg->countdown >= 0) {
+        snprintf(lines[3], OLED_LINE_LEN, "Remain: %ds", msg->countdown);
+    } else {
+        snprintf(lines[3], OLED_LINE_LEN, "Remain: --");
+    }
+}
+
+/**
+ * @brief OLED显示任务
+ * @param arg 任务参数（未使用）
+ *
+ * 等待采样通知（最长 400 ms）后按 oled_format_lines 的格式刷新屏幕
+ */
 static void oled_task(void *arg)
 {
     (void)arg;
-    char line1[24];
-    char line2[24];
-    char line3[24];
-    char line4[24];
+    STACK_CHECK(oled, "oled");
+    char lines[OLED_LINE_COUNT][OLED_LINE_LEN];
     sensor_msg_t latest = {0};
 
     // OLED硬件初始化
@@ -645,6 +1278,7 @@ static void oled_task(void *arg)
     oled_display_on();
     oled_clear();
     oled_refresh_gram();
+    boot_mark(BOOT_PHASE_OLED, BOOT_EVT_OLED);
     printf("OLED task started\r\n");
 
     // 上电自检提示，避免屏幕未刷新的空白
@@ -655,6 +1289,7 @@ static void oled_task(void *arg)
 
     // OLED实时显示状态循环
     while (1) {
+        task_heartbeat(SUP_TASK_OLED);
         // 等待新数据信号，超时则使用当前状态
         if (g_oled_sem != NULL && osSemaphoreAcquire(g_oled_sem, 400) == osOK) {
             if (g_sensor_queue != NULL) {
@@ -675,22 +1310,12 @@ static void oled_task(void *arg)
             latest.mode = state.mode;
         }
 
-        // 格式化显示内容
-        snprintf(line1, sizeof(line1), "Dryer: %s", latest.running ? "RUN" : "STOP");
-        snprintf(line2, sizeof(line2), "Mode: %s", mode_to_string(latest.mode));
-        snprintf(line3, sizeof(line3), "H:%u%%  T:%uC", latest.hum, latest.temp);
-        if (latest.running && latest.countdown >= 0) {
-            snprintf(line4, sizeof(line4), "Remain: %ds", latest.countdown);
-        } else {
-            snprintf(line4, sizeof(line4), "Remain: --");
-        }
-
-        // OLED显示更新
+        // 格式化显示内容并更新OLED
+        oled_format_lines(&latest, lines);
         oled_clear();
-        oled_showstring(0, 0, (const uint8_t *)line1, 12);
-        oled_showstring(0, 15, (const uint8_t *)line2, 12);
-        oled_showstring(0, 30, (const uint8_t *)line3, 12);
-        oled_showstring(0, 45, (const uint8_t *)line4, 12);
+        for (int i = 0; i < OLED_LINE_COUNT; i++) {
+            oled_showstring(0, (uint8_t)(i * 15), (const uint8_t *)lines[i], 12);
+        }
         oled_refresh_gram();
 
         usleep(400 * 1000);  // 400ms刷新周期
@@ -702,19 +1327,22 @@ static void oled_task(void *arg)
  * @param func 任务函数
  * @param task_id 任务ID输出参数
  * @param name 任务名称
+ * @param cb_mem 静态控制块，NULL 表示由内核堆分配
+ * @param stack_mem 静态栈，NULL 表示由内核堆分配
  * @param stack 栈大小（字节）
  * @param 任务优先级
  *
- * 统一的任务创建接口，便于错误处理和调试
+ * 统一的任务创建接口，便于错误处理和调试；调用方通过 TASK_MEM() 传入静态内存
  */
-static void create_task(osThreadFunc_t func, osThreadId_t *task_id, const char *name, uint32_t stack, osPriority_t priority)
+static void create_task(osThreadFunc_t func, osThreadId_t *task_id, const char *name,
+                        void *cb_mem, void *stack_mem, uint32_t stack, osPriority_t priority)
 {
     osThreadAttr_t attr = {
         .name = name,
         .attr_bits = 0U,
-        .cb_mem = NULL,
-        .cb_size = 0U,
-        .stack_mem = NULL,
+        .cb_mem = cb_mem,
+        .cb_size = cb_mem != NULL ? TASK_CB_SIZE : 0U,
+        .stack_mem = stack_mem,
         .stack_size = stack,
         .priority = priority
     };
@@ -722,64 +1350,432 @@ static void create_task(osThreadFunc_t func, osThreadId_t *task_id, const char *
     if (*task_id == NULL) {
         printf("Create task %s failed\r\n", name);
     }
+#ifdef SMART_LAUNDRY_STATIC_MEM
+    static_cb_check(name, *task_id, cb_mem, TASK_CB_SIZE);
+#endif
+}
+
+typedef struct {
+    osThreadFunc_t func;
+    osThreadId_t *task_id;
+    const char *name;
+    void *cb_mem;
+    void *stack_mem;
+    uint32_t stack;
+    osPriority_t priority;
+    uint32_t deadline_ms;
+    int restartable;        // 可单独重启；持有网络连接的任务卡死时直接热重启
+} task_desc_t;
+
+// 受监管任务表，按 sup_task_id_t 排列
+static const task_desc_t g_task_desc[SUP_TASK_COUNT] = {
+    {(osThreadFunc_t)control_task, &g_control_task_id, "dryer_ctrl", TASK_MEM(ctrl), TASK_STACK_CTRL,
+     osPriorityNormal1, SUP_DEADLINE_CTRL, 1},
+    {(osThreadFunc_t)motor_task, &g_motor_task_id, "motor_pwm", TASK_MEM(motor), TASK_STACK_MOTOR,
+     osPriorityNormal, SUP_DEADLINE_MOTOR, 1},
+    {(osThreadFunc_t)key_task, &g_key_task_id, "keys", TASK_MEM(keys), TASK_STACK_KEYS,
+     osPriorityNormal, SUP_DEADLINE_KEYS, 1},
+    {(osThreadFunc_t)oled_task, &g_oled_task_id, "oled", TASK_MEM(oled), TASK_STACK_OLED,
+     osPriorityNormal, SUP_DEADLINE_OLED, 1},
+    {(osThreadFunc_t)mqtt_send_task, &g_mqtt_send_task_id, "mqtt_send", TASK_MEM(mqtt_send), TASK_STACK_MQTT_SEND,
+     osPriorityNormal, SUP_DEADLINE_MQTT_SEND, 0},
+    {(osThreadFunc_t)mqtt_recv_task, &g_mqtt_recv_task_id, "mqtt_recv", TASK_MEM(mqtt_recv), TASK_STACK_MQTT_RECV,
+     osPriorityNormal, SUP_DEADLINE_MQTT_RECV, 0},
+};
+
+/**
+ * @brief 创建受监管任务并开始心跳监管
+ * @param id 任务ID
+ */
+static void start_task(sup_task_id_t id)
+{
+    const task_desc_t *desc = &g_task_desc[id];
+
+    sup_config(&g_sup, id, desc->name, desc->deadline_ms);
+    sup_start(&g_sup, id, uptime_ms());
+    create_task(desc->func, desc->task_id, desc->name, desc->cb_mem, desc->stack_mem, desc->stack, desc->priority);
+}
+
+#ifdef SMART_LAUNDRY_FAULT_INJECT
+/**
+ * @brief 故障注入：令指定任务停止心跳
+ * @param task 任务名称
+ * @param hard 非0时任务同时忽略退出请求，验证热重启路径
+ * @return 成功返回0，任务不存在或不受监管返回-1
+ */
+static int inject_hang(const char *task, int hard)
+{
+    for (int i = 0; i < SUP_TASK_COUNT; i++) {
+        if (equals_ignore_case(task, g_task_desc[i].name) && g_task_desc[i].deadline_ms != 0) {
+            printf("[sup] inject %s hang into %s at %ums\r\n", hard ? "hard" : "soft", g_task_desc[i].name,
+                   (unsigned int)uptime_ms());
+            if (hard) {
+                g_inject_hard_mask |= 1U << i;
+            }
+            uint32_t now = uptime_ms();
+            g_inject_at_ms[i] = now ? now : 1;
+            g_inject_hang_mask |= 1U << i;
+            return 0;
+        }
+    }
+    return -1;
+}
+#endif
+
+/**
+ * @brief 保存热重启现场到保留区
+ * @param reason 下次启动时报告的重启原因
+ * @param task 引发重启的任务，NULL 表示无
+ * @param now 当前时刻
+ *
+ * 状态锁被卡死任务持有时沿用上一次保存的状态与周期数据
+ */
+static void retained_save(sup_reset_reason_t reason, const char *task, uint32_t now)
+{
+    sup_retained_t retained;
+    uint32_t ticks = (SUP_LOCK_TIMEOUT_MS * osKernelGetTickFreq()) / 1000U + 1U;
+
+    memset(&retained, 0, sizeof(retained));
+    if (osMutexAcquire(g_state_lock, ticks) == osOK) {
+        retained.state = g_state;
+        retained.cycle = g_cycle;
+        osMutexRelease(g_state_lock);
+    } else if (sup_retained_valid(&g_retained)) {
+        retained.state = g_retained.state;
+        retained.cycle = g_retained.cycle;
+    } else {
+        return;
+    }
+    retained.warm_boots = g_warm_boots;
+    retained.saved_ms = now;
+    retained.reason = (uint8_t)reason;
+    if (task != NULL) {
+        snprintf(retained.task, sizeof(retained.task), "%s", task);
+    }
+    sup_retained_seal(&retained);
+    memcpy(&g_retained, &retained, sizeof(retained));
+}
+
+/**
+ * @brief 主动热重启前在 flash 中写入重启标记
+ * @param reason 重启原因
+ * @param task 引发重启的任务，NULL 表示无
+ *
+ * 标记与保留区相互独立：下次启动时有标记而保留区无效，说明保留区没有跨过复位
+ */
+static void reboot_marker_set(sup_reset_reason_t reason, const char *task)
+{
+    char value[REBOOT_MARKER_LEN];
+
+    snprintf(value, sizeof(value), "%u:%s", (unsigned int)reason, task != NULL ? task : "");
+    if (UtilsSetValue(REBOOT_MARKER_KEY, value) != 0) {
+        printf("[sup] reboot marker write failed\r\n");
+    }
+}
+
+/**
+ * @brief 读取并清除重启标记
+ * @param reason 输出参数，标记中的重启原因
+ * @param task 输出参数，标记中的任务名称
+ * @param len task 缓冲区大小
+ * @return 有有效标记返回1，否则返回0
+ */
+static int reboot_marker_take(sup_reset_reason_t *reason, char *task, size_t len)
+{
+    char value[REBOOT_MARKER_LEN] = {0};
+    char *end = NULL;
+
+    if (UtilsGetValue(REBOOT_MARKER_KEY, value, sizeof(value)) <= 0) {
+        return 0;
+    }
+    (void)UtilsDeleteValue(REBOOT_MARKER_KEY);
+    unsigned long code = strtoul(value, &end, 10);
+    if (end == value || *end != ':' || code >= SUP_RESET_MAX) {
+        return 0;
+    }
+    *reason = (sup_reset_reason_t)code;
+    snprintf(task, len, "%s", end + 1);
+    return 1;
+}
+
+/**
+ * @brief 从保留区恢复热重启前的现场
+ * @return 恢复成功返回1，冷启动返回0
+ *
+ * 恢复运行状态与进行中的周期，周期时间戳平移到本次上电的时基。
+ * 连续热重启超过 SUP_MAX_WARM_BOOTS 次时说明故障在每次启动后复现，改为停机恢复：
+ * 结束进行中的周期（停止原因 fault）并保持电机关闭，直到按键或云端重新启动。
+ * 保留区无效但 flash 中有重启标记时，说明上次主动热重启没能保住保留区（保留段未并入链接脚本
+ * 或被启动代码清零），按冷启动处理并报告 retained RAM lost
+ */
+static int retained_restore(void)
+{
+    sup_reset_reason_t marker_reason = SUP_RESET_POWER_ON;
+    char marker_task[SUP_NAME_LEN] = {0};
+    int marked = reboot_marker_take(&marker_reason, marker_task, sizeof(marker_task));
+
+#ifdef SMART_LAUNDRY_RETAINED_RAM
+    if ((char *)&g_retained < __sl_noinit_start || (char *)(&g_retained + 1) > __sl_noinit_end) {
+        printf("[sup] g_retained %p outside .sl_noinit [%p, %p)\r\n", (void *)&g_retained,
+               (void *)__sl_noinit_start, (void *)__sl_noinit_end);
+    }
+#endif
+    if (!sup_retained_valid(&g_retained)) {
+        if (marked) {
+            g_retained_lost = 1;
+            g_reset_reason = marker_reason;
+            snprintf(g_reset_task, sizeof(g_reset_task), "%s", marker_task);
+            printf("[sup] retained RAM lost across %s reboot (%s), cold start\r\n",
+                   sup_reset_reason_to_string(marker_reason), marker_task[0] ? marker_task : "-");
+        }
+        return 0;
+    }
+    g_reset_reason = (sup_reset_reason_t)g_retained.reason;
+    snprintf(g_reset_task, sizeof(g_reset_task), "%s", g_retained.task);
+    g_warm_boots = g_retained.warm_boots + 1;
+    g_state = g_retained.state;
+    g_cycle = g_retained.cycle;
+    dryer_cycle_rebase(&g_cycle, g_retained.saved_ms, uptime_ms());
+    if (g_warm_boots > SUP_MAX_WARM_BOOTS) {
+        g_safe_stop = 1;
+        if (g_state.running) {
+            cycle_summary_t summary;
+            dryer_apply_input(&g_state, DRYER_INPUT_STOP, 0);
+            if (dryer_cycle_update(&g_cycle, &g_state, CYCLE_REASON_FAULT, uptime_ms(), &summary)) {
+                log_cycle(&summary);
+            }
+        }
+    }
+    printf("[sup] warm boot #%u after %s (%s), dryer %s\r\n", (unsigned int)g_warm_boots,
+           sup_reset_reason_to_string(g_reset_reason), g_reset_task[0] ? g_reset_task : "-",
+           g_safe_stop ? "stopped: too many warm boots" : g_state.running ? "resumed" : "stopped");
+    return 1;
+}
+
+/**
+ * @brief 请求超时任务在心跳点退出，并等待内核确认任务已结束
+ * @param id 任务ID
+ * @return 任务已结束返回0，宽限期内未结束返回-1
+ *
+ * 不从外部 osThreadTerminate：任务可能正持有状态锁、追踪锁或驱动内部的锁，被终止后锁永不释放。
+ * 任务只在不持锁的心跳点自行退出；osThreadGetState 报告已结束之前不复用其控制块与栈
+ */
+static int task_stop(sup_task_id_t id)
+{
+    osThreadId_t task_id = *g_task_desc[id].task_id;
+    uint32_t ticks = (SUP_STOP_POLL_MS * osKernelGetTickFreq()) / 1000U + 1U;
+
+    g_task_stop[id] = 1;
+    for (uint32_t waited = 0; waited <= SUP_STOP_GRACE_MS; waited += SUP_STOP_POLL_MS) {
+        osThreadState_t state = task_id != NULL ? osThreadGetState(task_id) : osThreadInactive;
+        if (state == osThreadInactive || state == osThreadTerminated) {
+            *g_task_desc[id].task_id = NULL;
+            g_task_stop[id] = 0;
+            return 0;
+        }
+        osDelay(ticks);
+    }
+    return -1;  // 退出请求保持置位，热重启前任务若回到心跳点仍会退出
+}
+
+/**
+ * @brief 处理心跳超时任务
+ * @param id 超时任务ID
+ * @param now 当前时刻
+ * @param silent 距上次心跳的时长
+ *
+ * 先关闭电机，再请求该任务退出并重建；不可重启、宽限期内未退出或短时间内反复超时则保存现场并热重启
+ */
+static void supervisor_handle_fault(sup_task_id_t id, uint32_t now, uint32_t silent)
+{
+    const task_desc_t *desc = &g_task_desc[id];
+
+    g_motor_inhibit = 1;
+    DC_MOTOR(0);
+    printf("[sup] task %s missed deadline: silent %ums, limit %ums\r\n", desc->name, (unsigned int)silent,
+           (unsigned int)desc->deadline_ms);
+#ifdef SMART_LAUNDRY_FAULT_INJECT
+    if (g_inject_at_ms[id] != 0) {
+        printf("[sup] injected hang in %s detected after %ums\r\n", desc->name,
+               (unsigned int)(now - g_inject_at_ms[id]));
+        g_inject_at_ms[id] = 0;
+    }
+#endif
+
+    if (desc->restartable && sup_allow_restart(&g_sup, id, now, SUP_RESTART_WINDOW_MS, SUP_MAX_RESTARTS)) {
+        if (task_stop(id) == 0) {
+            dryer_trace_record(TRACE_EVT_FAULT, (uint8_t)id, 1);
+#ifdef SMART_LAUNDRY_FAULT_INJECT
+            g_inject_hang_mask &= ~(1U << id);
+            g_inject_hard_mask &= ~(1U << id);
+#endif
+            start_task(id);
+            printf("[sup] task %s restarted\r\n", desc->name);
+            return;
+        }
+        printf("[sup] task %s did not stop within %ums\r\n", desc->name, (unsigned int)SUP_STOP_GRACE_MS);
+    }
+
+    dryer_trace_record(TRACE_EVT_FAULT, (uint8_t)id, 0);
+    printf("[sup] task %s unrecoverable, warm reboot\r\n", desc->name);
+    retained_save(SUP_RESET_TASK_HANG, desc->name, now);
+    reboot_marker_set(SUP_RESET_TASK_HANG, desc->name);
+    hi_soft_reboot(HI_SYS_REBOOT_CAUSE_CMD);
+}
+
+/**
+ * @brief 任务监管任务
+ * @param arg 任务参数（未使用）
+ *
+ * 每 SUP_PERIOD_MS 检查一次各任务心跳：全部健康时喂硬件看门狗并解除电机禁止，
+ * 否则交由 supervisor_handle_fault 处理；监管任务自身卡死时由硬件看门狗复位。
+ * 每 SUP_SNAPSHOT_MS 刷新保留区现场，意外复位后仍可恢复运行状态；
+ * 每 SUP_HEAP_CHECK_MS 检查一次堆峰值是否超过启动完成时的水位；
+ * 上电后持续运行 SUP_HEALTHY_RUN_MS 时清零连续热重启计数
+ */
+static void supervisor_task(void *arg)
+{
+    (void)arg;
+    STACK_CHECK(sup, "supervisor");
+    uint32_t last_snapshot = uptime_ms();
+    uint32_t last_heap = last_snapshot;
+
+    IoTWatchDogEnable();
+    while (1) {
+        uint32_t now = uptime_ms();
+        uint32_t silent = 0;
+        int id = sup_check(&g_sup, now, &silent);
+        if (id < 0) {
+            g_motor_inhibit = 0;
+            IoTWatchDogKick();
+        } else {
+            supervisor_handle_fault((sup_task_id_t)id, now, silent);
+        }
+        if (now - last_snapshot >= SUP_SNAPSHOT_MS) {
+            retained_save(SUP_RESET_UNEXPECTED, NULL, now);
+            last_snapshot = now;
+        }
+        if (now - last_heap >= SUP_HEAP_CHECK_MS) {
+            heap_check();
+            last_heap = now;
+        }
+        if (g_warm_boots != 0 && now >= SUP_HEALTHY_RUN_MS) {
+            printf("[sup] up %us, warm boot count %u cleared\r\n", (unsigned int)(now / 1000U),
+                   (unsigned int)g_warm_boots);
+            g_warm_boots = 0;   // 下一次保留区刷新写入
+        }
+        usleep(SUP_PERIOD_MS * 1000);
+    }
+}
+
+/**
+ * @brief 网络启动任务
+ * @param arg 任务参数（未使用）
+ *
+ * 在独立任务中完成 Wi-Fi/MQTT 接入，与传感器、OLED 初始化并行进行；
+ * 接入成功后创建 MQTT 收发任务，待首次上报完成（或超时）后打印启动耗时分解
+ */
+static void net_task(void *arg)
+{
+    (void)arg;
+    STACK_CHECK(net, "net_boot");
+
+    if (wifi_mqtt_init() == 0) {
+        // 云端连接成功，创建MQTT相关任务
+        start_task(SUP_TASK_MQTT_SEND);
+        start_task(SUP_TASK_MQTT_RECV);
+        (void)boot_wait(BOOT_EVT_REPORT, BOOT_REPORT_TIMEOUT_MS);
+    } else {
+        printf("Cloud connection skipped, running offline\r\n");  // 离线模式运行
+        (void)boot_wait(BOOT_EVT_OLED | BOOT_EVT_SENSOR, BOOT_REPORT_TIMEOUT_MS);
+    }
+    boot_report();
+    mem_report();
 }
 
 /**
  * @brief 智慧洗衣房系统初始化函数
  *
  * 系统初始化流程：
- * 1. 创建全局状态互斥锁
- * 2. 初始化设备状态（默认标准模式、停止状态）
- * 3. 初始化LED指示灯
+ * 1. 创建全局状态互斥锁与启动事件
+ * 2. 恢复热重启前的现场，冷启动时初始化默认状态（标准模式、停止状态）
+ * 3. 初始化LED指示灯、周期核算与事件追踪
  * 4. 创建消息队列和信号量用于任务间通信
- * 5. 创建各个任务：控制、电机、按键、OLED
- * 6. 初始化Wi-Fi和MQTT连接（可选，失败时进入离线模式）
+ * 5. 创建各个任务：控制、电机、按键、OLED、网络启动与任务监管
+ *
+ * 初始化上下文不做任何阻塞等待，Wi-Fi/MQTT 接入由 net_task 并行完成（失败时进入离线模式）
  */
 static void smart_laundry_demo(void)
 {
+    hi_mdm_mem_info heap;
+
+    boot_mark(BOOT_PHASE_INIT, 0);
     printf("Smart laundry dryer demo start\r\n");
+    if (heap_sample(&heap) == 0) {
+        g_heap_init_used = heap.used;
+    }
 
-    // 1. 创建全局状态互斥锁，保护共享数据
-    g_state_lock = osMutexNew(NULL);
+    // 1. 创建全局状态互斥锁，保护共享数据；启动事件用于各阶段就绪通知
+    g_state_lock = osMutexNew(OBJ_ATTR(state_lock));
     if (g_state_lock == NULL) {
         printf("state mutex create failed\r\n");
         return;
     }
+    g_boot_events = osEventFlagsNew(OBJ_ATTR(boot_events));
+    if (g_boot_events == NULL) {
+        printf("boot event create failed\r\n");
+    }
+    OBJ_CHECK(state_lock, g_state_lock);
+    OBJ_CHECK(boot_events, g_boot_events);
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+    // 下行命令解析改用静态解析池
+    cJSON_Hooks json_hooks = {.malloc_fn = json_pool_malloc, .free_fn = json_pool_free};
+    cJSON_InitHooks(&json_hooks);
+#endif
+
+    // 2. 热重启时恢复运行状态与进行中的周期，否则初始化设备默认状态
+    sup_init(&g_sup);
+    int warm = retained_restore();
+    if (!warm) {
+        dryer_cycle_init(&g_cycle);
+        set_mode(DRY_MODE_STANDARD);    // 默认标准烘干模式
+        set_running(0);                  // 初始状态为停止
+        set_countdown(-1);              // 倒计时重置
+    }
 
-    // 2. 初始化设备默认状态
-    set_mode(DRY_MODE_STANDARD);    // 默认标准烘干模式
-    set_running(0);                  // 初始状态为停止
-    set_countdown(-1);              // 倒计时重置
-
-    // 3. 初始化LED指示灯
+    // 3. 初始化LED指示灯与事件追踪，追踪起点记录当前状态
     led_init();
+    LED(g_state.running ? 1 : 0);
+    (void)dryer_trace_init();
+    dryer_trace_state(&g_state);
 
     // 4. 创建任务间通信机制
-    g_sensor_queue = osMessageQueueNew(8, sizeof(sensor_msg_t), NULL);  // 传感器数据队列
-    g_oled_sem = osSemaphoreNew(8, 0, NULL);                            // OLED刷新信号量
+    uint32_t heap_before = heap_sample(&heap) == 0 ? heap.used : 0;
+    g_sensor_queue = osMessageQueueNew(SENSOR_QUEUE_DEPTH, sizeof(sensor_msg_t), OBJ_ATTR(sensor_queue));  // 传感器数据队列
+    g_oled_sem = osSemaphoreNew(OLED_SEM_MAX, 0, OBJ_ATTR(oled_sem));                                      // OLED刷新信号量
     if (g_sensor_queue == NULL || g_oled_sem == NULL) {
         printf("queue or semaphore create failed\r\n");
     }
+    OBJ_CHECK(sensor_queue, g_sensor_queue);
+    MQ_CHECK(sensor_queue, heap_before, SENSOR_QUEUE_DEPTH * sizeof(sensor_msg_t));
+    OBJ_CHECK(oled_sem, g_oled_sem);
     // 投递初始状态，确保 OLED 有数据可读
     if (g_sensor_queue != NULL) {
         sensor_msg_t init_msg = {0};
         (void)osMessageQueuePut(g_sensor_queue, &init_msg, 0, 0);
     }
 
-    // 5. 创建各个功能任务
-    create_task((osThreadFunc_t)control_task, &g_control_task_id, "dryer_ctrl", 4096, osPriorityNormal1);  // 主控制任务（最高优先级）
-    create_task((osThreadFunc_t)motor_task, &g_motor_task_id, "motor_pwm", 2048, osPriorityNormal);        // 电机PWM控制
-    create_task((osThreadFunc_t)key_task, &g_key_task_id, "keys", 2048, osPriorityNormal);                  // 按键处理
-    create_task((osThreadFunc_t)oled_task, &g_oled_task_id, "oled", 4096, osPriorityNormal);              // OLED显示
-
-    // 6. Wi-Fi/MQTT 初始化（放在任务创建之后，避免阻塞 OLED 刷新）
-    if (wifi_mqtt_init() == 0) {
-        // 云端连接成功，创建MQTT相关任务
-        create_task((osThreadFunc_t)mqtt_send_task, &g_mqtt_send_task_id, "mqtt_send", 8192, osPriorityNormal);
-        create_task((osThreadFunc_t)mqtt_recv_task, &g_mqtt_recv_task_id, "mqtt_recv", 4096, osPriorityNormal);
-    } else {
-        printf("Cloud connection skipped, running offline\r\n");  // 离线模式运行
-    }
+    // 5. 创建各个功能任务；网络接入放在独立任务中，与传感器/OLED 初始化重叠进行
+    start_task(SUP_TASK_CTRL);   // 主控制任务（最高优先级）
+    start_task(SUP_TASK_MOTOR);  // 电机PWM控制
+    start_task(SUP_TASK_KEYS);   // 按键处理
+    start_task(SUP_TASK_OLED);   // OLED显示
+    create_task((osThreadFunc_t)net_task, &g_net_task_id, "net_boot", TASK_MEM(net),
+                TASK_STACK_NET, osPriorityNormal);    // Wi-Fi/MQTT 接入
+    create_task((osThreadFunc_t)supervisor_task, &g_sup_task_id, "supervisor", TASK_MEM(sup),
+                TASK_STACK_SUP, osPriorityAboveNormal);  // 任务监管与看门狗
+    boot_mark(BOOT_PHASE_TASKS, 0);
 }
 
 SYS_RUN(smart_laundry_demo);
@@ -0,0 +1,143 @@
+/**
+ * 智慧洗衣房内存布局：任务栈、RTOS 控制块、队列与 JSON 缓冲区的编译期尺寸表。
+ *
+ * 定义 SMART_LAUNDRY_STATIC_MEM（BUILD.gn 中 smart_laundry_static_mem = true）时，
+ * 所有任务控制块、栈、队列缓冲区与 JSON 解析缓冲区均按本表静态分配，运行期不使用堆；
+ * 内核适配层不接受的部分以 SL_KERNEL_*_MEM=0 交还内核堆，见下文。
+ */
+
+#ifndef SMART_LAUNDRY_MEM_H
+#define SMART_LAUNDRY_MEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 任务栈大小（字节）
+#define TASK_STACK_CTRL 4096
+#define TASK_STACK_MOTOR 2048
+#define TASK_STACK_KEYS 2048
+#define TASK_STACK_OLED 4096
+#define TASK_STACK_NET 4096
+#define TASK_STACK_MQTT_SEND 8192
+#define TASK_STACK_MQTT_RECV 4096
+#define TASK_STACK_SUP 2048
+
+// 任务间通信与序列化缓冲区
+#define SENSOR_QUEUE_DEPTH 8
+#define SENSOR_MSG_MAX_SIZE 16
+#define OLED_SEM_MAX 8
+#define MQTT_TOPIC_BUF_SIZE 128
+#define MQTT_PAYLOAD_BUF_SIZE 256
+#define JSON_POOL_SIZE 2048         // 下行命令 cJSON 解析池，单条命令解析完即整体回收
+#define TRACE_CAPACITY 512          // 事件追踪环形缓冲区记录数（每条 8 字节）
+#define TRACE_CHUNK_MAX 32          // get_trace 单次回执最多导出的记录数
+#define CMD_RESP_BUF_SIZE 704       // 带数据的命令回执缓冲区，需容纳 TRACE_CHUNK_MAX 条记录的十六进制串与序号字段
+#define EVENT_PAYLOAD_BUF_SIZE 384  // 周期汇总事件上报缓冲区
+
+#define SL_U64_WORDS(bytes) (((bytes) + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+
+#ifdef SMART_LAUNDRY_STATIC_MEM
+/*
+ * RTOS 控制块大小直接取 LiteOS-M 的内核结构体，随内核版本与配置自动跟随。
+ * 启动时校验内核返回的句柄、任务栈与队列缓冲区是否落在传入的静态内存内。CMSIS 适配层忽略其中某类时
+ * （串口出现 "[mem] ... ignored cb_mem/stack_mem/mq_mem"），以对应的 SL_KERNEL_CB_MEM / SL_KERNEL_STACK_MEM /
+ * SL_KERNEL_MQ_MEM=0 编译：不再预留该类数组，也不计入静态预算，栈与队列缓冲区改由内核堆分配，mem_report 单独列出。
+ */
+#include "los_event.h"
+#include "los_mux.h"
+#include "los_queue.h"
+#include "los_sem.h"
+#include "los_task.h"
+
+#ifndef SL_KERNEL_CB_MEM
+#define SL_KERNEL_CB_MEM 1
+#endif
+#ifndef SL_KERNEL_STACK_MEM
+#define SL_KERNEL_STACK_MEM 1
+#endif
+#ifndef SL_KERNEL_MQ_MEM
+#define SL_KERNEL_MQ_MEM 1
+#endif
+// 移植层把内核结构体包在更大的控制块中时可在编译参数中放大，smart_laundry.c 以 _Static_assert 保证不小于内核结构体
+#ifndef SL_THREAD_CB_SIZE
+#define SL_THREAD_CB_SIZE sizeof(LosTaskCB)
+#endif
+#ifndef SL_MUTEX_CB_SIZE
+#define SL_MUTEX_CB_SIZE sizeof(LosMuxCB)
+#endif
+#ifndef SL_SEM_CB_SIZE
+#define SL_SEM_CB_SIZE sizeof(LosSemCB)
+#endif
+#ifndef SL_EVENT_CB_SIZE
+#define SL_EVENT_CB_SIZE sizeof(EVENT_CB_S)
+#endif
+#ifndef SL_MQ_CB_SIZE
+#define SL_MQ_CB_SIZE sizeof(LosQueueCB)
+#endif
+#define SL_MQ_MSG_OVERHEAD sizeof(UINT32)   // LiteOS-M 队列每条消息附带的长度字段
+
+#if SL_KERNEL_CB_MEM
+#define SL_CB_ARRAY(name, size) static uint64_t name[SL_U64_WORDS(size)]
+#define SL_CB_MEM(name) (name)
+#define SL_CB_BYTES(name) sizeof(name)
+#else
+#define SL_CB_ARRAY(name, size) typedef int name##_unused
+#define SL_CB_MEM(name) NULL
+#define SL_CB_BYTES(name) 0U
+#endif
+
+#if SL_KERNEL_STACK_MEM
+#define SL_STACK_ARRAY(name, size) static uint64_t name[(size) / sizeof(uint64_t)]
+#define SL_STACK_MEM(name) (name)
+#define SL_STACK_BYTES(name) sizeof(name)
+#else
+#define SL_STACK_ARRAY(name, size) typedef int name##_unused
+#define SL_STACK_MEM(name) NULL
+#define SL_STACK_BYTES(name) 0U
+#endif
+
+#if SL_KERNEL_MQ_MEM
+#define SL_MQ_ARRAY(name, size) static uint64_t name[SL_U64_WORDS(size)]
+#define SL_MQ_MEM(name) (name)
+#define SL_MQ_BYTES(name) sizeof(name)
+#else
+#define SL_MQ_ARRAY(name, size) typedef int name##_unused
+#define SL_MQ_MEM(name) NULL
+#define SL_MQ_BYTES(name) 0U
+#endif
+
+/**
+ * @brief 判断内核返回的对象地址是否落在传入的静态内存内
+ * @return 在范围内或未传入静态内存返回1，否则返回0（适配层忽略了传入的内存）
+ */
+static inline int sl_static_mem_inside(const void *addr, const void *mem, size_t size)
+{
+    uintptr_t p = (uintptr_t)addr;
+    uintptr_t base = (uintptr_t)mem;
+    return mem == NULL || addr == NULL || (p >= base && p < base + size);
+}
+#endif
+
+// 应用侧可用 SRAM 预算（字节），超出时编译失败
+#ifndef SL_RAM_BUDGET
+#define SL_RAM_BUDGET (48 * 1024)
+#endif
+
+#define SL_TASK_COUNT 8
+#define SL_MQ_MEM_SIZE(count, size) ((count) * ((((size) + 3U) & ~3U) + SL_MQ_MSG_OVERHEAD))
+
+#define SL_STACK_SIZES (TASK_STACK_CTRL + TASK_STACK_MOTOR + TASK_STACK_KEYS + TASK_STACK_OLED + \
+                        TASK_STACK_NET + TASK_STACK_MQTT_SEND + TASK_STACK_MQTT_RECV + TASK_STACK_SUP)
+#define SL_QUEUE_SIZE SL_MQ_MEM_SIZE(SENSOR_QUEUE_DEPTH, SENSOR_MSG_MAX_SIZE)
+
+// 静态预算只计实际交给内核的数组；SL_KERNEL_*_MEM=0 的部分来自内核堆，计入 SL_KHEAP_TOTAL
+#define SL_STACK_TOTAL (SL_KERNEL_STACK_MEM ? SL_STACK_SIZES : 0)
+#define SL_CB_TOTAL (SL_KERNEL_CB_MEM ? (SL_TASK_COUNT * SL_THREAD_CB_SIZE + 2 * SL_MUTEX_CB_SIZE + SL_SEM_CB_SIZE + \
+                                         SL_EVENT_CB_SIZE + SL_MQ_CB_SIZE) : 0)
+#define SL_QUEUE_TOTAL (SL_KERNEL_MQ_MEM ? SL_QUEUE_SIZE : 0)
+#define SL_KHEAP_TOTAL ((SL_STACK_SIZES - SL_STACK_TOTAL) + (SL_QUEUE_SIZE - SL_QUEUE_TOTAL))
+#define SL_BUFFER_TOTAL (JSON_POOL_SIZE + MQTT_TOPIC_BUF_SIZE + MQTT_PAYLOAD_BUF_SIZE + \
+                         TRACE_CAPACITY * 8 + CMD_RESP_BUF_SIZE + EVENT_PAYLOAD_BUF_SIZE)
+#define SL_RAM_TOTAL (SL_STACK_TOTAL + SL_CB_TOTAL + SL_QUEUE_TOTAL + SL_BUFFER_TOTAL)
+
+#endif /* SMART_LAUNDRY_MEM_H */
@@ -0,0 +1,49 @@
+/**
+ * 基准测试堆分配计数：链接时以 -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ * 拦截固件与 cJSON 的堆调用，统计次数与字节数。libc 内部分配不经过此处。
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bench_alloc.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static uint64_t g_alloc_count;
+static uint64_t g_alloc_bytes;
+
+void *__wrap_malloc(size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_alloc_bytes, size, __ATOMIC_RELAXED);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_alloc_bytes, nmemb * size, __ATOMIC_RELAXED);
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_alloc_bytes, size, __ATOMIC_RELAXED);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    __real_free(ptr);
+}
+
+void bench_alloc_read(bench_alloc_t *out)
+{
+    out->count = __atomic_load_n(&g_alloc_count, __ATOMIC_RELAXED);
+    out->bytes = __atomic_load_n(&g_alloc_bytes, __ATOMIC_RELAXED);
+}
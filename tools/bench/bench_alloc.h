@@ -0,0 +1,20 @@
+/**
+ * 基准测试堆分配计数接口，见 bench_alloc.c。
+ */
+
+#ifndef BENCH_ALLOC_H
+#define BENCH_ALLOC_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t count;
+    uint64_t bytes;
+} bench_alloc_t;
+
+/**
+ * @brief 读取进程启动以来的累计分配次数与字节数
+ */
+void bench_alloc_read(bench_alloc_t *out);
+
+#endif /* BENCH_ALLOC_H */
@@ -0,0 +1,513 @@
+/**
+ * 固件热路径主机端基准测试：直接包含 smart_laundry.c，以 tools/bench/host 中的 pthread 适配层
+ * 替代 LiteOS-M 与板级驱动，逐项测量 ns/op、每次操作的堆分配次数与峰值栈用量。
+ *
+ * 每轮计时前先测一次固定的参考负载（格式化 + 散列），输出 ref_ns 与 ns_per_op/ref_ns 比值；
+ * 同一主机上比值基本不受 CPU 频率与虚拟机抖动影响，基线比较以比值为准。
+ *
+ * state_snapshot_mix 按固件实际的任务组合并发运行：控制、按键、云端命令三个写者与电机、OLED、
+ * MQTT 上报三个快照读者，另外输出读者单次 get_state_snapshot 耗时的 p50/p90/p99/max。
+ *
+ * 由 tools/bench/run_bench.py 编译运行并与基线比较；单独使用时：
+ *   bench_main [-o result.json] [-f filter]
+ * 结果以 JSON 输出。固件日志照常格式化但不输出，避免 stdio 刷新时机影响耗时与栈深度。
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench_alloc.h"
+
+static int bench_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// 固件的 static 函数与全局状态需在同一编译单元内访问
+#define printf bench_printf
+#include "smart_laundry.c"
+#undef printf
+
+#define BENCH_REPEAT 5              // 每项重复次数，取中位数
+#define BENCH_MIN_RUN_NS 20000000ULL  // 单次重复的最短耗时，迭代次数按此自动标定
+#define BENCH_MAX_ITERS (1U << 24)
+#define BENCH_STACK_SIZE (256 * 1024)
+#define BENCH_STACK_PATTERN 0xA5
+#define BENCH_STACK_ITERS 64        // 峰值栈测量时执行的操作次数，覆盖各分支
+#define BENCH_REF_ITERS 20000       // 参考负载每轮次数
+#define BENCH_TASKS 6               // 并发用例的线程数，对应访问运行状态的六个固件任务
+#define BENCH_LAT_SAMPLES 65536     // 每个计时任务保留的单次耗时样本数
+
+#define BENCH_TOPIC "$oc/devices/" DEVICE_ID "/sys/commands/request_id=bench-0001"
+
+typedef struct {
+    const char *task;           // 对应的固件任务
+    void (*op)(uint32_t i);
+    int timed;                  // 该任务中 get_state_snapshot 的单次耗时计入分位数
+} bench_role_t;
+
+typedef struct {
+    const char *name;
+    const char *desc;
+    void (*op)(uint32_t i);
+    const bench_role_t *roles;  // 非NULL时 BENCH_TASKS 个线程各按角色同时执行，按总耗时/总次数计 ns/op
+} bench_case_t;
+
+typedef struct {
+    uint32_t stride;            // 每 stride 次调用保留一个样本
+    uint32_t count;
+    uint32_t max;               // 全部调用中的最大耗时
+    uint32_t ns[BENCH_LAT_SAMPLES];
+} bench_lat_t;
+
+typedef struct {
+    const char *name;
+    uint32_t iterations;
+    double ns_per_op;
+    double ns_min;
+    double ref_ns;
+    double ratio;
+    double allocs_per_op;
+    double bytes_per_op;
+    uint32_t peak_stack;
+    int has_lat;
+    uint32_t lat_p50;
+    uint32_t lat_p90;
+    uint32_t lat_p99;
+    uint32_t lat_max;
+} bench_result_t;
+
+typedef struct {
+    void (*op)(uint32_t i);
+    uint32_t iters;
+    pthread_barrier_t *start;   // 并发用例的同步起跑点，NULL 表示无
+    bench_lat_t *lat;           // 单次耗时样本，NULL 表示不记录
+} bench_job_t;
+
+static unsigned char g_bench_topic[] = BENCH_TOPIC;
+static unsigned char g_bench_set_mode[3][64];
+static unsigned char g_bench_get_trace[] = "{\"command_name\":\"get_trace\",\"paras\":{\"count\":32}}";
+static char g_bench_lines[OLED_LINE_COUNT][OLED_LINE_LEN];
+static volatile uint32_t g_bench_sink;
+static bench_lat_t g_bench_lat[BENCH_TASKS];
+static __thread bench_lat_t *t_bench_lat;     // 当前线程的耗时样本
+static __thread int t_bench_duty = -1;        // 电机角色上次提交的占空比
+
+/**
+ * @brief 固件日志替身：格式化到丢弃缓冲区，保留格式化开销
+ */
+static int bench_printf(const char *fmt, ...)
+{
+    static char sink[256];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(sink, sizeof(sink), fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void op_noop(uint32_t i)
+{
+    g_bench_sink += i;
+}
+
+/**
+ * @brief 参考负载：与固件热路径相近的格式化与逐字节处理，不含被测代码
+ */
+static void op_reference(uint32_t i)
+{
+    char buf[96];
+    int n = snprintf(buf, sizeof(buf), "{\"ref\":\"%s\",\"n\":%u,\"v\":%d}", (i & 1) ? "odd" : "even",
+                     (unsigned int)i, (int)(i % 97) - 48);
+    uint32_t hash = 2166136261U;
+    for (int k = 0; k < n; k++) {
+        hash = (hash ^ (uint8_t)buf[k]) * 16777619U;
+    }
+    g_bench_sink += hash;
+}
+
+static void op_properties_payload(uint32_t i)
+{
+    (void)i;
+    g_bench_sink += (uint32_t)package_properties_payload(g_report_payload, sizeof(g_report_payload));
+}
+
+static void op_sub_callback_set_mode(uint32_t i)
+{
+    // 每次实际切换档位，覆盖状态提交与追踪记录路径
+    g_bench_sink += (uint32_t)mqtt_client_sub_callback(g_bench_topic, g_bench_set_mode[i % 3]);
+}
+
+static void op_sub_callback_get_trace(uint32_t i)
+{
+    (void)i;
+    g_bench_sink += (uint32_t)mqtt_client_sub_callback(g_bench_topic, g_bench_get_trace);
+}
+
+static void op_state_snapshot(uint32_t i)
+{
+    (void)i;
+    dryer_state_t state = get_state_snapshot();
+    g_bench_sink += state.humidity;
+}
+
+/**
+ * @brief 计时的状态快照：记录单次耗时，含等待状态锁的时间
+ */
+static dryer_state_t timed_snapshot(uint32_t i)
+{
+    uint64_t start = now_ns();
+    dryer_state_t state = get_state_snapshot();
+    uint64_t ns = now_ns() - start;
+    bench_lat_t *lat = t_bench_lat;
+
+    if (lat != NULL) {
+        uint32_t v = ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+        lat->max = v > lat->max ? v : lat->max;
+        if (i % lat->stride == 0 && lat->count < BENCH_LAT_SAMPLES) {
+            lat->ns[lat->count++] = v;
+        }
+    }
+    return state;
+}
+
+static void op_control_step(uint32_t i)
+{
+    // 湿度低于阈值，每 COUNTDOWN_SECONDS 步走完一次倒计时停机；停机后立即重新启动
+    if (!g_state.running) {
+        (void)apply_input(TRACE_EVT_KEY, DRYER_INPUT_START, 0);
+    }
+    control_step((uint8_t)(20 + (i & 7)), (uint8_t)(HUMIDITY_THRESHOLD - 5 + (i % 5)));
+}
+
+static void op_oled_format(uint32_t i)
+{
+    sensor_msg_t msg = {
+        .temp = (uint8_t)(20 + (i & 15)),
+        .hum = (uint8_t)(30 + (i & 63)),
+        .countdown = (int)(i % (COUNTDOWN_SECONDS + 2)) - 1,
+        .running = (int)(i & 1),
+        .mode = (dry_mode_t)(i % DRY_MODE_MAX)
+    };
+    oled_format_lines(&msg, g_bench_lines);
+    g_bench_sink += (uint32_t)g_bench_lines[3][8];
+}
+
+static void op_mix_keys(uint32_t i)
+{
+    // 以切换档位为主，偶尔启停
+    (void)apply_input(TRACE_EVT_KEY, (i & 63) ? DRYER_INPUT_NEXT_MODE : DRYER_INPUT_TOGGLE, 0);
+}
+
+static void op_mix_cloud(uint32_t i)
+{
+    (void)apply_input(TRACE_EVT_CLOUD, DRYER_INPUT_SET_MODE, (int)(i % DRY_MODE_MAX));
+}
+
+static void op_mix_motor(uint32_t i)
+{
+    // 与 motor_task 相同：读快照，占空比变化时在状态锁内积分周期电机时间
+    dryer_state_t state = timed_snapshot(i);
+    int duty = state.running ? g_mode_duty[state.mode] : 0;
+    if (duty != t_bench_duty) {
+        dryer_trace_record(TRACE_EVT_DUTY, (uint8_t)duty, 0);
+        osMutexAcquire(g_state_lock, osWaitForever);
+        dryer_cycle_duty(&g_cycle, (uint8_t)duty, uptime_ms());
+        osMutexRelease(g_state_lock);
+        t_bench_duty = duty;
+    }
+}
+
+static void op_mix_reader(uint32_t i)
+{
+    dryer_state_t state = timed_snapshot(i);
+    g_bench_sink += state.humidity;
+}
+
+// 访问运行状态的固件任务：三个写者（控制、按键、云端命令）与三个快照读者（电机、OLED、MQTT 上报）
+static const bench_role_t g_task_mix[BENCH_TASKS] = {
+    {"dryer_ctrl", op_control_step, 0},
+    {"keys", op_mix_keys, 0},
+    {"mqtt_recv", op_mix_cloud, 0},
+    {"motor_pwm", op_mix_motor, 1},
+    {"oled", op_mix_reader, 1},
+    {"mqtt_send", op_mix_reader, 1},
+};
+
+static const bench_case_t g_cases[] = {
+    {"properties_payload", "package_properties_payload", op_properties_payload, NULL},
+    {"sub_callback_set_mode", "mqtt_client_sub_callback: set_mode gear", op_sub_callback_set_mode, NULL},
+    {"sub_callback_get_trace", "mqtt_client_sub_callback: get_trace 32 records", op_sub_callback_get_trace, NULL},
+    {"state_snapshot", "get_state_snapshot, uncontended", op_state_snapshot, NULL},
+    {"state_snapshot_mix", "get_state_snapshot latency under the 3 writer / 3 reader task mix", op_mix_reader,
+     g_task_mix},
+    {"control_step", "control_task sample + countdown step", op_control_step, NULL},
+    {"oled_format", "oled_task line formatting", op_oled_format, NULL},
+};
+
+static void *job_thread(void *arg)
+{
+    const bench_job_t *job = arg;
+    t_bench_lat = job->lat;
+    t_bench_duty = -1;
+    if (job->start != NULL) {
+        pthread_barrier_wait(job->start);
+    }
+    for (uint32_t i = 0; i < job->iters; i++) {
+        job->op(i);
+    }
+    return NULL;
+}
+
+/**
+ * @brief 在预填充图案的独立栈上执行操作，返回栈的最大使用深度
+ */
+static uint32_t stack_high_water(void (*op)(uint32_t i), uint32_t iters)
+{
+    static uint8_t stack[BENCH_STACK_SIZE] __attribute__((aligned(64)));
+    bench_job_t job = {op, iters, NULL, NULL};
+    pthread_attr_t attr;
+    pthread_t tid;
+
+    memset(stack, BENCH_STACK_PATTERN, sizeof(stack));
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, sizeof(stack));
+    if (pthread_create(&tid, &attr, job_thread, &job) != 0) {
+        pthread_attr_destroy(&attr);
+        return 0;
+    }
+    pthread_join(tid, NULL);
+    pthread_attr_destroy(&attr);
+
+    size_t low = 0;
+    while (low < sizeof(stack) && stack[low] == BENCH_STACK_PATTERN) {
+        low++;
+    }
+    return (uint32_t)(sizeof(stack) - low);
+}
+
+/**
+ * @brief 执行一轮计时
+ * @param lat 非NULL时计时角色的单次耗时写入 lat[角色]
+ * @return 本轮总耗时（ns）；并发用例为 BENCH_TASKS 个线程各执行 iters 次的墙钟时间
+ */
+static uint64_t run_iters(const bench_case_t *bc, uint32_t iters, bench_lat_t *lat)
+{
+    if (bc->roles == NULL) {
+        uint64_t start = now_ns();
+        for (uint32_t i = 0; i < iters; i++) {
+            bc->op(i);
+        }
+        return now_ns() - start;
+    }
+
+    pthread_barrier_t barrier;
+    pthread_t tids[BENCH_TASKS];
+    bench_job_t jobs[BENCH_TASKS];
+    int started = 0;
+
+    pthread_barrier_init(&barrier, NULL, BENCH_TASKS + 1);
+    for (; started < BENCH_TASKS; started++) {
+        const bench_role_t *role = &bc->roles[started];
+        jobs[started] = (bench_job_t){role->op, iters, &barrier, (lat != NULL && role->timed) ? &lat[started] : NULL};
+        if (pthread_create(&tids[started], NULL, job_thread, &jobs[started]) != 0) {
+            fprintf(stderr, "bench: thread create failed\n");
+            exit(2);
+        }
+    }
+    pthread_barrier_wait(&barrier);
+    uint64_t start = now_ns();
+    for (int t = 0; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    uint64_t elapsed = now_ns() - start;
+    pthread_barrier_destroy(&barrier);
+    return elapsed;
+}
+
+static int cmp_double(const void *lhs, const void *rhs)
+{
+    double a = *(const double *)lhs;
+    double b = *(const double *)rhs;
+    return (a > b) - (a < b);
+}
+
+static int cmp_u32(const void *lhs, const void *rhs)
+{
+    uint32_t a = *(const uint32_t *)lhs;
+    uint32_t b = *(const uint32_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief 合并各计时角色的样本，计算单次耗时分位数
+ */
+static void lat_percentiles(const bench_lat_t *lat, bench_result_t *res)
+{
+    static uint32_t merged[BENCH_TASKS * BENCH_LAT_SAMPLES];
+    size_t n = 0;
+
+    res->lat_max = 0;
+    for (int t = 0; t < BENCH_TASKS; t++) {
+        memcpy(&merged[n], lat[t].ns, lat[t].count * sizeof(merged[0]));
+        n += lat[t].count;
+        res->lat_max = lat[t].max > res->lat_max ? lat[t].max : res->lat_max;
+    }
+    if (n == 0) {
+        return;
+    }
+    qsort(merged, n, sizeof(merged[0]), cmp_u32);
+    res->has_lat = 1;
+    res->lat_p50 = merged[n * 50 / 100];
+    res->lat_p90 = merged[n * 90 / 100];
+    res->lat_p99 = merged[n * 99 / 100];
+}
+
+static void run_case(const bench_case_t *bc, uint32_t stack_base, bench_result_t *res)
+{
+    double samples[BENCH_REPEAT];
+    double refs[BENCH_REPEAT];
+    double ratios[BENCH_REPEAT];
+    const bench_case_t ref = {"reference", "reference workload", op_reference, NULL};
+    bench_alloc_t before;
+    bench_alloc_t after;
+    uint32_t iters = 1000;
+    double ops = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+
+    // 预热并标定迭代次数
+    while (iters < BENCH_MAX_ITERS && run_iters(bc, iters, NULL) < BENCH_MIN_RUN_NS) {
+        iters *= 2;
+    }
+
+    // 单次耗时样本覆盖全部重复轮次
+    memset(g_bench_lat, 0, sizeof(g_bench_lat));
+    for (int t = 0; t < BENCH_TASKS; t++) {
+        g_bench_lat[t].stride = (uint32_t)(((uint64_t)iters * BENCH_REPEAT) / BENCH_LAT_SAMPLES + 1);
+    }
+
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+        double n = (double)iters * (bc->roles != NULL ? BENCH_TASKS : 1);
+        refs[r] = (double)run_iters(&ref, BENCH_REF_ITERS, NULL) / BENCH_REF_ITERS;
+        bench_alloc_read(&before);
+        samples[r] = (double)run_iters(bc, iters, g_bench_lat) / n;
+        bench_alloc_read(&after);
+        ratios[r] = samples[r] / refs[r];
+        allocs += after.count - before.count;
+        bytes += after.bytes - before.bytes;
+        ops += n;
+    }
+
+    qsort(samples, BENCH_REPEAT, sizeof(samples[0]), cmp_double);
+    qsort(refs, BENCH_REPEAT, sizeof(refs[0]), cmp_double);
+    qsort(ratios, BENCH_REPEAT, sizeof(ratios[0]), cmp_double);
+    uint32_t stack = stack_high_water(bc->op, BENCH_STACK_ITERS);
+
+    res->name = bc->name;
+    res->iterations = iters;
+    res->ns_per_op = samples[BENCH_REPEAT / 2];
+    res->ns_min = samples[0];
+    res->ref_ns = refs[BENCH_REPEAT / 2];
+    res->ratio = ratios[BENCH_REPEAT / 2];
+    res->allocs_per_op = (double)allocs / ops;
+    res->bytes_per_op = (double)bytes / ops;
+    res->peak_stack = stack > stack_base ? stack - stack_base : 0;
+    if (bc->roles != NULL) {
+        lat_percentiles(g_bench_lat, res);
+    }
+}
+
+/**
+ * @brief 按固件启动流程初始化全局状态，并预填追踪缓冲区供 get_trace 读取
+ */
+static void bench_setup(void)
+{
+    smart_laundry_demo();
+    for (int m = 0; m < 3; m++) {
+        snprintf((char *)g_bench_set_mode[m], sizeof(g_bench_set_mode[m]),
+                 "{\"command_name\":\"set_mode\",\"paras\":{\"gear\":%d}}", m + 1);
+    }
+    for (uint32_t i = 0; i < TRACE_CAPACITY; i++) {
+        op_control_step(i);
+    }
+}
+
+static void print_json(FILE *out, const bench_result_t *results, size_t count)
+{
+#ifdef SMART_LAUNDRY_STATIC_MEM
+    const char *variant = "static_mem";
+#else
+    const char *variant = "default";
+#endif
+    fprintf(out, "{\n  \"schema\": 1,\n  \"variant\": \"%s\",\n  \"pointer_bits\": %u,\n  \"results\": [\n", variant,
+            (unsigned int)(sizeof(void *) * 8));
+    for (size_t i = 0; i < count; i++) {
+        const bench_result_t *r = &results[i];
+        fprintf(out,
+                "    {\"name\": \"%s\", \"iterations\": %u, \"ns_per_op\": %.1f, \"ns_min\": %.1f, "
+                "\"ref_ns\": %.1f, \"ratio\": %.4f, \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f, "
+                "\"peak_stack_bytes\": %u",
+                r->name, (unsigned int)r->iterations, r->ns_per_op, r->ns_min, r->ref_ns, r->ratio, r->allocs_per_op,
+                r->bytes_per_op, (unsigned int)r->peak_stack);
+        if (r->has_lat) {
+            fprintf(out, ", \"lat_p50_ns\": %u, \"lat_p90_ns\": %u, \"lat_p99_ns\": %u, \"lat_max_ns\": %u",
+                    (unsigned int)r->lat_p50, (unsigned int)r->lat_p90, (unsigned int)r->lat_p99,
+                    (unsigned int)r->lat_max);
+        }
+        fprintf(out, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = NULL;
+    const char *filter = NULL;
+    bench_result_t results[sizeof(g_cases) / sizeof(g_cases[0])] = {0};
+    size_t count = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:f:")) != -1) {
+        if (opt == 'o') {
+            out_path = optarg;
+        } else if (opt == 'f') {
+            filter = optarg;
+        } else {
+            fprintf(stderr, "usage: %s [-o result.json] [-f filter]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // 结果写到原标准输出或文件，其余模块的日志丢弃
+    FILE *out = out_path != NULL ? fopen(out_path, "w") : fdopen(dup(STDOUT_FILENO), "w");
+    if (out == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "bench: cannot open output\n");
+        return 2;
+    }
+
+    bench_setup();
+    uint32_t stack_base = stack_high_water(op_noop, 1);
+    for (size_t i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++) {
+        if (filter != NULL && strstr(g_cases[i].name, filter) == NULL) {
+            continue;
+        }
+        fprintf(stderr, "bench: %-24s %s\n", g_cases[i].name, g_cases[i].desc);
+        run_case(&g_cases[i], stack_base, &results[count++]);
+    }
+    print_json(out, results, count);
+    fclose(out);
+    return 0;
+}
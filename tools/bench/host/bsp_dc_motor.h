@@ -0,0 +1,11 @@
+#ifndef BENCH_BSP_DC_MOTOR_H
+#define BENCH_BSP_DC_MOTOR_H
+
+#include <stdint.h>
+
+void dc_motor_init(void);
+void bench_gpio_write(int pin, uint8_t value);
+
+#define DC_MOTOR(a) bench_gpio_write(14, (uint8_t)(a))
+
+#endif /* BENCH_BSP_DC_MOTOR_H */
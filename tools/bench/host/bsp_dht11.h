@@ -0,0 +1,9 @@
+#ifndef BENCH_BSP_DHT11_H
+#define BENCH_BSP_DHT11_H
+
+#include <stdint.h>
+
+uint8_t dht11_init(void);
+uint8_t dht11_read_data(uint8_t *temp, uint8_t *humi);
+
+#endif /* BENCH_BSP_DHT11_H */
@@ -0,0 +1,12 @@
+#ifndef BENCH_BSP_KEY_H
+#define BENCH_BSP_KEY_H
+
+#include <stdint.h>
+
+#define KEY1_PRESS 1
+#define KEY2_PRESS 2
+
+void key_init(void);
+uint8_t key_scan(uint8_t mode);
+
+#endif /* BENCH_BSP_KEY_H */
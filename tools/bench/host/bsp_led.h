@@ -0,0 +1,11 @@
+#ifndef BENCH_BSP_LED_H
+#define BENCH_BSP_LED_H
+
+#include <stdint.h>
+
+void led_init(void);
+void bench_gpio_write(int pin, uint8_t value);
+
+#define LED(a) bench_gpio_write(2, (uint8_t)(a))
+
+#endif /* BENCH_BSP_LED_H */
@@ -0,0 +1,14 @@
+#ifndef BENCH_BSP_MQTT_H
+#define BENCH_BSP_MQTT_H
+
+#include <stdint.h>
+
+extern int8_t (*p_MQTTClient_sub_callback)(unsigned char *topic, unsigned char *payload);
+
+int MQTTClient_connectServer(const char *ip_addr, int ip_port);
+int MQTTClient_init(char *client_id, char *username, char *password);
+int MQTTClient_subscribe(char *topic);
+int MQTTClient_sub(void);
+int MQTTClient_pub(char *topic, unsigned char *payload, int payload_len);
+
+#endif /* BENCH_BSP_MQTT_H */
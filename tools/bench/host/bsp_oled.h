@@ -0,0 +1,12 @@
+#ifndef BENCH_BSP_OLED_H
+#define BENCH_BSP_OLED_H
+
+#include <stdint.h>
+
+void oled_init(void);
+void oled_display_on(void);
+void oled_clear(void);
+void oled_refresh_gram(void);
+void oled_showstring(uint8_t x, uint8_t y, const uint8_t *p, uint8_t size);
+
+#endif /* BENCH_BSP_OLED_H */
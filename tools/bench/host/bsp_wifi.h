@@ -0,0 +1,8 @@
+#ifndef BENCH_BSP_WIFI_H
+#define BENCH_BSP_WIFI_H
+
+#define WIFI_SUCCESS 0
+
+int WiFi_connectHotspots(const char *ssid, const char *psk);
+
+#endif /* BENCH_BSP_WIFI_H */
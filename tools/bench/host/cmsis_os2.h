@@ -0,0 +1,108 @@
+/**
+ * 主机端 CMSIS-RTOS2 适配（仅基准测试使用）：互斥锁、信号量与事件标志基于 pthread 实现，
+ * 只覆盖 smart_laundry.c 用到的接口。
+ */
+
+#ifndef BENCH_CMSIS_OS2_H
+#define BENCH_CMSIS_OS2_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef void *osThreadId_t;
+typedef void *osMutexId_t;
+typedef void *osSemaphoreId_t;
+typedef void *osEventFlagsId_t;
+typedef void *osMessageQueueId_t;
+typedef void (*osThreadFunc_t)(void *argument);
+
+typedef enum {
+    osOK = 0,
+    osError = -1,
+    osErrorTimeout = -2,
+    osErrorResource = -3,
+    osErrorParameter = -4,
+    osErrorNoMemory = -5,
+} osStatus_t;
+
+typedef enum {
+    osThreadInactive = 0,
+    osThreadReady = 1,
+    osThreadRunning = 2,
+    osThreadBlocked = 3,
+    osThreadTerminated = 4,
+    osThreadError = -1,
+} osThreadState_t;
+
+typedef enum {
+    osPriorityLow = 8,
+    osPriorityBelowNormal = 16,
+    osPriorityNormal = 24,
+    osPriorityNormal1 = 25,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh = 40,
+} osPriority_t;
+
+typedef struct {
+    const char *name;
+    uint32_t attr_bits;
+    void *cb_mem;
+    uint32_t cb_size;
+    void *stack_mem;
+    uint32_t stack_size;
+    osPriority_t priority;
+    uint32_t tz_module;
+    uint32_t reserved;
+} osThreadAttr_t;
+
+typedef struct {
+    const char *name;
+    uint32_t attr_bits;
+    void *cb_mem;
+    uint32_t cb_size;
+} osMutexAttr_t;
+
+typedef osMutexAttr_t osSemaphoreAttr_t;
+typedef osMutexAttr_t osEventFlagsAttr_t;
+
+typedef struct {
+    const char *name;
+    uint32_t attr_bits;
+    void *cb_mem;
+    uint32_t cb_size;
+    void *mq_mem;
+    uint32_t mq_size;
+} osMessageQueueAttr_t;
+
+#define osWaitForever 0xFFFFFFFFU
+#define osFlagsWaitAny 0x00000000U
+#define osFlagsWaitAll 0x00000001U
+#define osFlagsNoClear 0x00000002U
+#define osFlagsError 0x80000000U
+#define osFlagsErrorTimeout 0xFFFFFFFEU
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr);
+osThreadState_t osThreadGetState(osThreadId_t thread_id);
+void osThreadExit(void) __attribute__((noreturn));
+osStatus_t osDelay(uint32_t ticks);
+uint32_t osKernelGetTickCount(void);
+uint32_t osKernelGetTickFreq(void);
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr);
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr);
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout);
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr);
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags);
+uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout);
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr);
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout);
+osStatus_t osMessageQueueTryPut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout);
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
+
+#endif /* BENCH_CMSIS_OS2_H */
@@ -0,0 +1,19 @@
+#ifndef BENCH_HI_MEM_H
+#define BENCH_HI_MEM_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t total;
+    uint32_t used;
+    uint32_t free;
+    uint32_t free_node_num;
+    uint32_t used_node_num;
+    uint32_t max_free_node_size;
+    uint32_t malloc_fail_count;
+    uint32_t peek_size;
+} hi_mdm_mem_info;
+
+uint32_t hi_mem_get_sys_info(hi_mdm_mem_info *mem_inf);
+
+#endif /* BENCH_HI_MEM_H */
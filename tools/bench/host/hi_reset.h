@@ -0,0 +1,10 @@
+#ifndef BENCH_HI_RESET_H
+#define BENCH_HI_RESET_H
+
+typedef enum {
+    HI_SYS_REBOOT_CAUSE_CMD = 1,
+} hi_sys_reboot_cause;
+
+void hi_soft_reboot(hi_sys_reboot_cause cause);
+
+#endif /* BENCH_HI_RESET_H */
@@ -0,0 +1,648 @@
+/**
+ * 主机端 RTOS 与板级外设适配（基准测试与主机仿真共用）。
+ *
+ * 内核对象基于 pthread，时基 1 kHz；外设为空实现，MQTT 发布只计数，
+ * 使固件热路径在主机上的耗时只包含应用自身的逻辑与格式化开销。
+ * 主机仿真通过 g_host_os（见 host_os.h）打开真实任务线程，为 Wi-Fi/DHCP/MQTT 接入设定耗时，
+ * 并可注入温湿度读数、按键与下行命令。
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bsp_dc_motor.h"
+#include "bsp_dht11.h"
+#include "bsp_key.h"
+#include "bsp_led.h"
+#include "bsp_mqtt.h"
+#include "bsp_oled.h"
+#include "bsp_wifi.h"
+#include "cmsis_os2.h"
+#include "hi_mem.h"
+#include "hi_reset.h"
+#include "host_os.h"
+#include "iot_watchdog.h"
+#include "kv_store.h"
+#include "lwip/netifapi.h"
+
+#define HOST_TICK_FREQ 1000U
+#define HOST_KV_SLOTS 4
+#define HOST_KV_LEN 128
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t value;             // 信号量计数或事件标志位
+    uint32_t max;
+} host_sync_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t count;
+    uint32_t size;
+    uint32_t head;
+    uint32_t used;
+    uint8_t data[];
+} host_queue_t;
+
+typedef struct {
+    osThreadFunc_t func;
+    void *argument;
+    volatile osThreadState_t state;
+} host_thread_t;
+
+typedef struct {
+    char key[32];
+    char value[HOST_KV_LEN];
+} host_kv_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    const char *topic;          // 待接收任务取走的命令，NULL 表示没有待取的命令
+    const char *payload;
+    uint32_t posted;            // 已投递的命令数
+    uint32_t handled;           // 回调已返回的命令数
+} host_downlink_t;
+
+static host_kv_t g_host_kv[HOST_KV_SLOTS];     // 键值存储，仅在进程内有效
+static host_downlink_t g_downlink = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0, 0};
+
+host_os_config_t g_host_os;
+static volatile uint32_t g_wifi_up_ms;          // Wi-Fi 连接完成时刻，0 表示未连接
+
+int8_t (*p_MQTTClient_sub_callback)(unsigned char *topic, unsigned char *payload);
+volatile uint32_t g_bench_mqtt_pubs;
+volatile uint32_t g_bench_gpio_writes;
+
+/**
+ * @brief 由超时 tick 数计算绝对截止时刻
+ */
+static void deadline_after(uint32_t ticks, struct timespec *ts)
+{
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += ticks / HOST_TICK_FREQ;
+    ts->tv_nsec += (long)(ticks % HOST_TICK_FREQ) * (1000000000L / HOST_TICK_FREQ);
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static host_sync_t *sync_new(uint32_t value, uint32_t max)
+{
+    host_sync_t *sync = calloc(1, sizeof(*sync));
+    if (sync == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&sync->lock, NULL);
+    pthread_cond_init(&sync->cond, NULL);
+    sync->value = value;
+    sync->max = max;
+    return sync;
+}
+
+/**
+ * @brief 按毫秒休眠
+ */
+static void sleep_ms(uint32_t ms)
+{
+    struct timespec ts = {ms / 1000U, (long)(ms % 1000U) * 1000000L};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+static void thread_cleanup(void *arg)
+{
+    ((host_thread_t *)arg)->state = osThreadTerminated;
+}
+
+static void *thread_entry(void *arg)
+{
+    host_thread_t *thread = arg;
+
+    // 任务函数返回或调用 osThreadExit 时均标记为已结束
+    pthread_cleanup_push(thread_cleanup, thread);
+    thread->func(thread->argument);
+    pthread_cleanup_pop(1);
+    return NULL;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+    pthread_t tid;
+
+    // 基准程序直接调用被测函数，不创建固件任务；优先级、控制块与栈内存由主机调度器忽略
+    (void)attr;
+    if (!g_host_os.threads) {
+        return NULL;
+    }
+    host_thread_t *thread = calloc(1, sizeof(*thread));  // 句柄不回收，结束后仍可查询状态
+    if (thread == NULL) {
+        return NULL;
+    }
+    thread->func = func;
+    thread->argument = argument;
+    thread->state = osThreadReady;
+    if (pthread_create(&tid, NULL, thread_entry, thread) != 0) {
+        free(thread);
+        return NULL;
+    }
+    pthread_detach(tid);
+    return thread;
+}
+
+osThreadState_t osThreadGetState(osThreadId_t thread_id)
+{
+    host_thread_t *thread = thread_id;
+    return thread != NULL ? thread->state : osThreadError;
+}
+
+void osThreadExit(void)
+{
+    pthread_exit(NULL);
+}
+
+osStatus_t osDelay(uint32_t ticks)
+{
+    struct timespec ts = {ticks / HOST_TICK_FREQ, (long)(ticks % HOST_TICK_FREQ) * 1000000L};
+    nanosleep(&ts, NULL);
+    return osOK;
+}
+
+static struct timespec g_power_on;
+
+/**
+ * @brief 进程启动即“上电”，tick 从0开始计数，与设备上 uptime 的含义一致
+ */
+__attribute__((constructor)) static void host_power_on(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &g_power_on);
+}
+
+uint32_t osKernelGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t ns = (int64_t)(ts.tv_sec - g_power_on.tv_sec) * 1000000000L + (ts.tv_nsec - g_power_on.tv_nsec);
+    return (uint32_t)(ns / (1000000000L / HOST_TICK_FREQ));
+}
+
+uint32_t osKernelGetTickFreq(void)
+{
+    return HOST_TICK_FREQ;
+}
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr)
+{
+    (void)attr;
+    pthread_mutex_t *mutex = calloc(1, sizeof(*mutex));
+    if (mutex != NULL) {
+        pthread_mutex_init(mutex, NULL);
+    }
+    return mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
+{
+    if (mutex_id == NULL) {
+        return osErrorParameter;
+    }
+    if (timeout == osWaitForever) {
+        return pthread_mutex_lock(mutex_id) == 0 ? osOK : osError;
+    }
+    if (timeout == 0) {
+        return pthread_mutex_trylock(mutex_id) == 0 ? osOK : osErrorResource;
+    }
+    struct timespec ts;
+    deadline_after(timeout, &ts);
+    return pthread_mutex_timedlock(mutex_id, &ts) == 0 ? osOK : osErrorTimeout;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id)
+{
+    if (mutex_id == NULL) {
+        return osErrorParameter;
+    }
+    return pthread_mutex_unlock(mutex_id) == 0 ? osOK : osErrorResource;
+}
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
+{
+    (void)attr;
+    return sync_new(initial_count, max_count);
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    host_sync_t *sem = semaphore_id;
+    struct timespec ts;
+    osStatus_t ret = osOK;
+
+    if (sem == NULL) {
+        return osErrorParameter;
+    }
+    deadline_after(timeout == osWaitForever ? 0 : timeout, &ts);
+    pthread_mutex_lock(&sem->lock);
+    while (sem->value == 0) {
+        if (timeout == 0) {
+            ret = osErrorResource;
+            break;
+        }
+        int err = timeout == osWaitForever ? pthread_cond_wait(&sem->cond, &sem->lock)
+                                           : pthread_cond_timedwait(&sem->cond, &sem->lock, &ts);
+        if (err == ETIMEDOUT) {
+            ret = osErrorTimeout;
+            break;
+        }
+    }
+    if (ret == osOK) {
+        sem->value--;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ret;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
+{
+    host_sync_t *sem = semaphore_id;
+    osStatus_t ret = osOK;
+
+    if (sem == NULL) {
+        return osErrorParameter;
+    }
+    pthread_mutex_lock(&sem->lock);
+    if (sem->value < sem->max) {
+        sem->value++;
+        pthread_cond_signal(&sem->cond);
+    } else {
+        ret = osErrorResource;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ret;
+}
+
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
+{
+    (void)attr;
+    return sync_new(0, 0);
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
+{
+    host_sync_t *ef = ef_id;
+
+    if (ef == NULL) {
+        return osFlagsError;
+    }
+    pthread_mutex_lock(&ef->lock);
+    ef->value |= flags;
+    uint32_t value = ef->value;
+    pthread_cond_broadcast(&ef->cond);
+    pthread_mutex_unlock(&ef->lock);
+    return value;
+}
+
+uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    host_sync_t *ef = ef_id;
+    struct timespec ts;
+    uint32_t ret;
+
+    if (ef == NULL) {
+        return osFlagsError;
+    }
+    deadline_after(timeout == osWaitForever ? 0 : timeout, &ts);
+    pthread_mutex_lock(&ef->lock);
+    while (1) {
+        uint32_t hit = ef->value & flags;
+        if ((options & osFlagsWaitAll) ? hit == flags : hit != 0) {
+            ret = ef->value;
+            if (!(options & osFlagsNoClear)) {
+                ef->value &= ~flags;
+            }
+            break;
+        }
+        if (timeout == 0 || (timeout != osWaitForever &&
+                             pthread_cond_timedwait(&ef->cond, &ef->lock, &ts) == ETIMEDOUT)) {
+            ret = osFlagsErrorTimeout;
+            break;
+        }
+        if (timeout == osWaitForever) {
+            pthread_cond_wait(&ef->cond, &ef->lock);
+        }
+    }
+    pthread_mutex_unlock(&ef->lock);
+    return ret;
+}
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+    (void)attr;
+    host_queue_t *mq = calloc(1, sizeof(*mq) + (size_t)msg_count * msg_size);
+    if (mq != NULL) {
+        pthread_mutex_init(&mq->lock, NULL);
+        mq->count = msg_count;
+        mq->size = msg_size;
+    }
+    return mq;
+}
+
+osStatus_t osMessageQueueTryPut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+    host_queue_t *mq = mq_id;
+    osStatus_t ret = osOK;
+
+    (void)msg_prio;
+    (void)timeout;
+    if (mq == NULL) {
+        return osErrorParameter;
+    }
+    pthread_mutex_lock(&mq->lock);
+    if (mq->used < mq->count) {
+        memcpy(&mq->data[((mq->head + mq->used) % mq->count) * mq->size], msg_ptr, mq->size);
+        mq->used++;
+    } else {
+        ret = osErrorResource;
+    }
+    pthread_mutex_unlock(&mq->lock);
+    return ret;
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+    return osMessageQueueTryPut(mq_id, msg_ptr, msg_prio, timeout);
+}
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
+{
+    host_queue_t *mq = mq_id;
+    osStatus_t ret = osOK;
+
+    (void)timeout;
+    if (mq == NULL) {
+        return osErrorParameter;
+    }
+    pthread_mutex_lock(&mq->lock);
+    if (mq->used > 0) {
+        memcpy(msg_ptr, &mq->data[mq->head * mq->size], mq->size);
+        mq->head = (mq->head + 1) % mq->count;
+        mq->used--;
+        if (msg_prio != NULL) {
+            *msg_prio = 0;
+        }
+    } else {
+        ret = osErrorResource;
+    }
+    pthread_mutex_unlock(&mq->lock);
+    return ret;
+}
+
+void bench_gpio_write(int pin, uint8_t value)
+{
+    (void)pin;
+    (void)value;
+    g_bench_gpio_writes++;
+}
+
+void dc_motor_init(void) {}
+void led_init(void) {}
+void key_init(void) {}
+
+uint8_t key_scan(uint8_t mode)
+{
+    (void)mode;
+    return __atomic_exchange_n(&g_host_os.key_press, 0, __ATOMIC_SEQ_CST);
+}
+
+uint8_t dht11_init(void)
+{
+    return 0;
+}
+
+uint8_t dht11_read_data(uint8_t *temp, uint8_t *humi)
+{
+    if (g_host_os.dht11_read != NULL) {
+        return g_host_os.dht11_read(temp, humi);
+    }
+    *temp = 25;
+    *humi = 60;
+    return 0;
+}
+
+void oled_init(void) {}
+void oled_display_on(void) {}
+void oled_clear(void) {}
+void oled_refresh_gram(void) {}
+
+void oled_showstring(uint8_t x, uint8_t y, const uint8_t *p, uint8_t size)
+{
+    (void)x;
+    (void)y;
+    (void)p;
+    (void)size;
+}
+
+/**
+ * @brief 模拟一次网络接入步骤
+ * @return 在线时休眠指定时长后返回0，离线返回-1
+ */
+static int net_step(uint32_t ms)
+{
+    if (!g_host_os.online) {
+        return -1;
+    }
+    sleep_ms(ms);
+    return 0;
+}
+
+int WiFi_connectHotspots(const char *ssid, const char *psk)
+{
+    (void)ssid;
+    (void)psk;
+    if (net_step(g_host_os.wifi_ms) != 0) {
+        return -1;
+    }
+    uint32_t now = osKernelGetTickCount();
+    g_wifi_up_ms = now ? now : 1;
+    return 0;
+}
+
+int MQTTClient_connectServer(const char *ip_addr, int ip_port)
+{
+    (void)ip_addr;
+    (void)ip_port;
+    return net_step(g_host_os.mqtt_connect_ms);
+}
+
+int MQTTClient_init(char *client_id, char *username, char *password)
+{
+    (void)client_id;
+    (void)username;
+    (void)password;
+    return net_step(g_host_os.mqtt_init_ms);
+}
+
+int MQTTClient_subscribe(char *topic)
+{
+    (void)topic;
+    return net_step(g_host_os.mqtt_subscribe_ms);
+}
+
+int MQTTClient_sub(void)
+{
+    if (!g_host_os.online) {
+        return -1;
+    }
+    // 与设备上一样一直阻塞在接收上，逐条回调 host_mqtt_deliver 投递的命令
+    pthread_mutex_lock(&g_downlink.lock);
+    while (1) {
+        while (g_downlink.topic == NULL) {
+            pthread_cond_wait(&g_downlink.cond, &g_downlink.lock);
+        }
+        unsigned char *topic = (unsigned char *)(uintptr_t)g_downlink.topic;
+        unsigned char *payload = (unsigned char *)(uintptr_t)g_downlink.payload;
+        g_downlink.topic = NULL;    // 已取走，投递方等待回调返回
+        pthread_cond_broadcast(&g_downlink.cond);
+        pthread_mutex_unlock(&g_downlink.lock);
+        if (p_MQTTClient_sub_callback != NULL) {
+            (void)p_MQTTClient_sub_callback(topic, payload);
+        }
+        pthread_mutex_lock(&g_downlink.lock);
+        g_downlink.handled++;
+        pthread_cond_broadcast(&g_downlink.cond);
+    }
+}
+
+int host_mqtt_deliver(const char *topic, const char *payload, uint32_t timeout_ms)
+{
+    struct timespec ts;
+
+    deadline_after(timeout_ms * (HOST_TICK_FREQ / 1000U), &ts);
+    pthread_mutex_lock(&g_downlink.lock);
+    while (g_downlink.posted != g_downlink.handled) {
+        if (pthread_cond_timedwait(&g_downlink.cond, &g_downlink.lock, &ts) == ETIMEDOUT) {
+            pthread_mutex_unlock(&g_downlink.lock);
+            return -1;
+        }
+    }
+    g_downlink.topic = topic;
+    g_downlink.payload = payload;
+    uint32_t ticket = ++g_downlink.posted;
+    pthread_cond_broadcast(&g_downlink.cond);
+    while (g_downlink.topic == topic) {
+        if (pthread_cond_timedwait(&g_downlink.cond, &g_downlink.lock, &ts) == ETIMEDOUT &&
+            g_downlink.topic == topic) {
+            // 接收任务没有取走命令，撤回
+            g_downlink.topic = NULL;
+            g_downlink.posted--;
+            pthread_mutex_unlock(&g_downlink.lock);
+            return -1;
+        }
+    }
+    while (g_downlink.handled != ticket) {
+        pthread_cond_wait(&g_downlink.cond, &g_downlink.lock);
+    }
+    pthread_mutex_unlock(&g_downlink.lock);
+    return 0;
+}
+
+int MQTTClient_pub(char *topic, unsigned char *payload, int payload_len)
+{
+    (void)topic;
+    (void)payload;
+    if (g_host_os.link_down) {
+        return -1;
+    }
+    g_bench_mqtt_pubs++;
+    return payload_len;
+}
+
+struct netif *netifapi_netif_find(const char *name)
+{
+    static struct netif wlan;
+
+    // Wi-Fi 连接 dhcp_ms 之后网卡获得地址
+    (void)name;
+    if (g_wifi_up_ms == 0 || osKernelGetTickCount() - g_wifi_up_ms < g_host_os.dhcp_ms) {
+        return NULL;
+    }
+    wlan.ip_addr.addr = 0x0A00A8C0U;  // 192.168.0.10
+    return &wlan;
+}
+
+void IoTWatchDogEnable(void) {}
+void IoTWatchDogKick(void) {}
+void IoTWatchDogDisable(void) {}
+
+void hi_soft_reboot(hi_sys_reboot_cause cause)
+{
+    if (g_host_os.reboot_hook != NULL) {
+        g_host_os.reboot_hook((int)cause);
+    }
+    fprintf(stderr, "[bench] unexpected soft reboot (cause %d)\n", (int)cause);
+    abort();
+}
+
+uint32_t hi_mem_get_sys_info(hi_mdm_mem_info *mem_inf)
+{
+    // glibc 不记录历史峰值，以当前已分配量代替
+    struct mallinfo2 mi = mallinfo2();
+    memset(mem_inf, 0, sizeof(*mem_inf));
+    mem_inf->total = (uint32_t)mi.arena;
+    mem_inf->used = (uint32_t)mi.uordblks;
+    mem_inf->free = (uint32_t)mi.fordblks;
+    mem_inf->peek_size = (uint32_t)mi.uordblks;
+    return 0;
+}
+
+static host_kv_t *kv_find(const char *key)
+{
+    for (int i = 0; i < HOST_KV_SLOTS; i++) {
+        if (strcmp(g_host_kv[i].key, key) == 0) {
+            return &g_host_kv[i];
+        }
+    }
+    return NULL;
+}
+
+int UtilsGetValue(const char *key, char *value, unsigned int len)
+{
+    host_kv_t *kv = kv_find(key);
+    if (kv == NULL || len == 0) {
+        return -1;
+    }
+    snprintf(value, len, "%s", kv->value);
+    return (int)strlen(value);
+}
+
+int UtilsSetValue(const char *key, const char *value)
+{
+    host_kv_t *kv = kv_find(key);
+    if (kv == NULL) {
+        kv = kv_find("");
+    }
+    if (kv == NULL || strlen(key) >= sizeof(kv->key)) {
+        return -1;
+    }
+    snprintf(kv->key, sizeof(kv->key), "%s", key);
+    snprintf(kv->value, sizeof(kv->value), "%s", value);
+    return 0;
+}
+
+int UtilsDeleteValue(const char *key)
+{
+    host_kv_t *kv = kv_find(key);
+    if (kv == NULL) {
+        return -1;
+    }
+    memset(kv, 0, sizeof(*kv));
+    return 0;
+}
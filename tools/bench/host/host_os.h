@@ -0,0 +1,36 @@
+/**
+ * 主机端适配层的运行时配置。默认值对应基准测试：不创建固件任务、网络不可用、软复位即中止；
+ * 主机仿真（tools/host_sim.c）在调用 smart_laundry_demo() 前修改。
+ */
+
+#ifndef BENCH_HOST_OS_H
+#define BENCH_HOST_OS_H
+
+#include <stdint.h>
+
+typedef struct {
+    int threads;                    // 非0时 osThreadNew 以 pthread 运行固件任务
+    int online;                     // 非0时 Wi-Fi/MQTT 接入成功，否则立即失败
+    volatile int link_down;         // 非0时 MQTTClient_pub 失败，MQTTClient_sub 照常阻塞（对端无响应的断链）
+    uint32_t wifi_ms;               // WiFi_connectHotspots 耗时
+    uint32_t dhcp_ms;               // Wi-Fi 连接后到网卡获得 IP 的时长
+    uint32_t mqtt_connect_ms;       // MQTTClient_connectServer 耗时（TCP 建连）
+    uint32_t mqtt_init_ms;          // MQTTClient_init 耗时（CONNECT/CONNACK）
+    uint32_t mqtt_subscribe_ms;     // MQTTClient_subscribe 耗时（SUBSCRIBE/SUBACK）
+    void (*reboot_hook)(int cause); // hi_soft_reboot 时调用，为 NULL 时中止进程
+    uint8_t (*dht11_read)(uint8_t *temp, uint8_t *humi);  // 代替 dht11_read_data 的固定读数（25℃/60%RH），可为 NULL
+    volatile uint8_t key_press;     // 非0时下一次 key_scan 返回该键值并清零，模拟一次按键
+} host_os_config_t;
+
+extern host_os_config_t g_host_os;
+
+/**
+ * @brief 投递一条下行命令，由固件接收任务在 MQTTClient_sub 中回调 p_MQTTClient_sub_callback 处理
+ * @param topic 命令主题
+ * @param payload 命令内容
+ * @param timeout_ms 等待接收任务取走命令的时长
+ * @return 回调返回后返回0，超时未被取走（接收任务未运行或离线）返回-1
+ */
+int host_mqtt_deliver(const char *topic, const char *payload, uint32_t timeout_ms);
+
+#endif /* BENCH_HOST_OS_H */
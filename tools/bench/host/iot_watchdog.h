@@ -0,0 +1,8 @@
+#ifndef BENCH_IOT_WATCHDOG_H
+#define BENCH_IOT_WATCHDOG_H
+
+void IoTWatchDogEnable(void);
+void IoTWatchDogKick(void);
+void IoTWatchDogDisable(void);
+
+#endif /* BENCH_IOT_WATCHDOG_H */
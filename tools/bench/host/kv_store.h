@@ -0,0 +1,8 @@
+#ifndef BENCH_KV_STORE_H
+#define BENCH_KV_STORE_H
+
+int UtilsGetValue(const char *key, char *value, unsigned int len);
+int UtilsSetValue(const char *key, const char *value);
+int UtilsDeleteValue(const char *key);
+
+#endif /* BENCH_KV_STORE_H */
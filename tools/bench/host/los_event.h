@@ -0,0 +1,15 @@
+/**
+ * 主机端占位：字段按 LiteOS-M 的 EVENT_CB_S 排列，仅用于静态内存尺寸计算。
+ */
+
+#ifndef BENCH_LOS_EVENT_H
+#define BENCH_LOS_EVENT_H
+
+#include "los_typedef.h"
+
+typedef struct tagEvent {
+    UINT32 uwEventID;
+    LOS_DL_LIST stEventList;
+} EVENT_CB_S;
+
+#endif /* BENCH_LOS_EVENT_H */
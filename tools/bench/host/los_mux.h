@@ -0,0 +1,19 @@
+/**
+ * 主机端占位：字段按 LiteOS-M 的 LosMuxCB 排列，仅用于静态内存尺寸计算。
+ */
+
+#ifndef BENCH_LOS_MUX_H
+#define BENCH_LOS_MUX_H
+
+#include "los_typedef.h"
+
+typedef struct {
+    UINT8 muxStat;
+    UINT16 muxCount;
+    UINT32 muxID;
+    LOS_DL_LIST muxList;
+    VOID *owner;
+    UINT16 priority;
+} LosMuxCB;
+
+#endif /* BENCH_LOS_MUX_H */
@@ -0,0 +1,23 @@
+/**
+ * 主机端占位：字段按 LiteOS-M 的 LosQueueCB 排列，仅用于静态内存尺寸计算。
+ */
+
+#ifndef BENCH_LOS_QUEUE_H
+#define BENCH_LOS_QUEUE_H
+
+#include "los_typedef.h"
+
+typedef struct {
+    UINT8 *queue;
+    UINT16 queueState;
+    UINT16 queueLen;
+    UINT16 queueSize;
+    UINT16 queueID;
+    UINT16 queueHead;
+    UINT16 queueTail;
+    UINT16 readWriteableCnt[2];
+    LOS_DL_LIST readWriteList[2];
+    LOS_DL_LIST memList;
+} LosQueueCB;
+
+#endif /* BENCH_LOS_QUEUE_H */
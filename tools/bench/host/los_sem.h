@@ -0,0 +1,18 @@
+/**
+ * 主机端占位：字段按 LiteOS-M 的 LosSemCB 排列，仅用于静态内存尺寸计算。
+ */
+
+#ifndef BENCH_LOS_SEM_H
+#define BENCH_LOS_SEM_H
+
+#include "los_typedef.h"
+
+typedef struct {
+    UINT16 semStat;
+    UINT16 semCount;
+    UINT16 maxSemCount;
+    UINT16 semID;
+    LOS_DL_LIST semList;
+} LosSemCB;
+
+#endif /* BENCH_LOS_SEM_H */
@@ -0,0 +1,36 @@
+/**
+ * 主机端占位：字段按 LiteOS-M 的 LosTaskCB 排列，仅用于静态内存尺寸计算。
+ */
+
+#ifndef BENCH_LOS_TASK_H
+#define BENCH_LOS_TASK_H
+
+#include "los_event.h"
+#include "los_typedef.h"
+
+typedef struct {
+    VOID *stackPointer;
+    UINT16 taskStatus;
+    UINT16 priority;
+    INT32 timeSlice;
+    UINT32 waitTimes;
+    LOS_DL_LIST sortList;
+    UINT64 responseTime;
+    UINT32 stackSize;
+    UINT32 topOfStack;
+    UINT32 taskID;
+    VOID *taskEntry;
+    VOID *taskSem;
+    VOID *taskMux;
+    UINT32 arg;
+    CHAR *taskName;
+    LOS_DL_LIST pendList;
+    LOS_DL_LIST timerList;
+    EVENT_CB_S event;
+    UINT32 eventMask;
+    UINT32 eventMode;
+    VOID *msg;
+    INT32 errorNo;
+} LosTaskCB;
+
+#endif /* BENCH_LOS_TASK_H */
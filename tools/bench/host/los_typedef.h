@@ -0,0 +1,23 @@
+/**
+ * 主机端 LiteOS-M 基础类型占位，供 los_*.h 占位头文件使用。
+ */
+
+#ifndef BENCH_LOS_TYPEDEF_H
+#define BENCH_LOS_TYPEDEF_H
+
+#include <stdint.h>
+
+typedef uint8_t UINT8;
+typedef uint16_t UINT16;
+typedef uint32_t UINT32;
+typedef uint64_t UINT64;
+typedef int32_t INT32;
+typedef char CHAR;
+typedef void VOID;
+
+typedef struct LOS_DL_LIST {
+    struct LOS_DL_LIST *pstPrev;
+    struct LOS_DL_LIST *pstNext;
+} LOS_DL_LIST;
+
+#endif /* BENCH_LOS_TYPEDEF_H */
@@ -0,0 +1 @@
+/* 主机端占位：smart_laundry.c 未使用其中接口 */
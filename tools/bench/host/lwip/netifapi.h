@@ -0,0 +1,20 @@
+#ifndef BENCH_LWIP_NETIFAPI_H
+#define BENCH_LWIP_NETIFAPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t addr;
+} ip4_addr_t;
+
+struct netif {
+    ip4_addr_t ip_addr;
+};
+
+struct netif *netifapi_netif_find(const char *name);
+
+#define netif_ip4_addr(nif) ((const ip4_addr_t *)&(nif)->ip_addr)
+#define ip4_addr_isany(ipaddr) ((ipaddr) == NULL || (ipaddr)->addr == 0)
+
+#endif /* BENCH_LWIP_NETIFAPI_H */
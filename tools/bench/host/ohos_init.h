@@ -0,0 +1,10 @@
+/**
+ * 主机端 ohos_init.h 适配：SYS_RUN 只保留入口引用，基准程序不启动固件任务。
+ */
+
+#ifndef BENCH_OHOS_INIT_H
+#define BENCH_OHOS_INIT_H
+
+#define SYS_RUN(func) void (*const g_bench_sys_run_entry)(void) = func
+
+#endif /* BENCH_OHOS_INIT_H */
@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""
+固件热路径主机端基准测试：编译 tools/bench/bench_main.c（直接包含 src/smart_laundry.c），
+分别测量默认构建与全静态内存构建，输出 JSON 结果并与基线比较。
+
+用法：
+  python3 tools/bench/run_bench.py                     # 运行并与 baseline.json 比较
+  python3 tools/bench/run_bench.py --output out.json   # 同时写出本次结果
+  python3 tools/bench/run_bench.py --update-baseline   # 以本次结果覆盖基线
+
+判定规则（任一项不满足退出码为 1，编译/运行失败为 2）：
+  - ratio（ns_per_op 与同轮参考负载耗时之比）不超过基线 × (1 + threshold)，
+    可抵消 CPU 频率与虚拟机抖动；基线来自不同主机/编译器时跳过，除非 --strict-time
+  - allocs_per_op 不超过基线
+  - peak_stack_bytes 不超过基线 + stack-slack
+并发用例的单次耗时分位数（lat_*_ns）受主机调度影响大，只列出不判定。
+"""
+
+import argparse
+import json
+import os
+import platform
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+from typing import Any, Dict, List, Optional
+
+REPO_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+BENCH_DIR = os.path.join(REPO_ROOT, "tools", "bench")
+DEFAULT_BASELINE = os.path.join(BENCH_DIR, "baseline.json")
+# 本仓库位于 OpenHarmony 源码树的 vendor/pzkj/pz_hi3861/demo/49_Exam 下
+DEFAULT_CJSON_DIR = os.path.join(REPO_ROOT, "..", "..", "..", "..", "..", "third_party", "cJSON")
+VARIANTS = {
+    "default": [],
+    "static_mem": ["-DSMART_LAUNDRY_STATIC_MEM"],
+}
+FIRMWARE_SOURCES = [
+    "src/dryer_logic.c",
+    "src/dryer_cycle.c",
+    "src/dryer_trace.c",
+    "src/dryer_supervisor.c",
+]
+BENCH_SOURCES = [
+    "tools/bench/bench_main.c",
+    "tools/bench/bench_alloc.c",
+    "tools/bench/host/host_os.c",
+]
+WRAP_FLAGS = "-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free"
+LATENCY_KEYS = ["lat_p50_ns", "lat_p90_ns", "lat_p99_ns", "lat_max_ns"]
+
+
+def host_fingerprint(cc: str) -> Dict[str, str]:
+    cpu = platform.processor() or ""
+    try:
+        with open("/proc/cpuinfo", encoding="utf-8") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    cpu = line.split(":", 1)[1].strip()
+                    break
+    except OSError:
+        pass
+    try:
+        compiler = subprocess.run([cc, "--version"], capture_output=True, text=True, check=True).stdout
+        compiler = compiler.splitlines()[0].strip()
+    except (OSError, subprocess.CalledProcessError, IndexError):
+        compiler = cc
+    return {"machine": platform.machine(), "cpu": cpu, "compiler": compiler}
+
+
+def build_variant(cc: str, cjson_dir: str, variant: str, out_dir: str) -> str:
+    binary = os.path.join(out_dir, f"bench_{variant}")
+    cmd = [cc, "-O2", "-std=gnu99", "-Wall", "-g", *VARIANTS[variant],
+           "-I" + os.path.join(BENCH_DIR, "host"), "-I" + BENCH_DIR, "-I" + os.path.join(REPO_ROOT, "src"),
+           "-I" + cjson_dir,
+           *[os.path.join(REPO_ROOT, s) for s in BENCH_SOURCES + FIRMWARE_SOURCES],
+           os.path.join(cjson_dir, "cJSON.c"),
+           "-o", binary, "-lpthread", "-lm", WRAP_FLAGS]
+    proc = subprocess.run(cmd, capture_output=True, text=True)
+    if proc.returncode != 0:
+        sys.stderr.write(proc.stderr)
+        raise RuntimeError(f"build failed for variant {variant}")
+    return binary
+
+
+def run_variant(binary: str, case_filter: Optional[str], runs: int) -> Dict[str, Any]:
+    """多次运行取各项 ns/op 中位数，抵消进程间的地址布局与调度抖动"""
+    cmd = [binary]
+    if case_filter:
+        cmd += ["-f", case_filter]
+    samples: Dict[str, List[Dict[str, Any]]] = {}
+    for _ in range(runs):
+        proc = subprocess.run(cmd, capture_output=True, text=True)
+        if proc.returncode != 0:
+            sys.stderr.write(proc.stderr)
+            raise RuntimeError(f"{os.path.basename(binary)} exited with {proc.returncode}")
+        for r in json.loads(proc.stdout)["results"]:
+            samples.setdefault(r.pop("name"), []).append(r)
+
+    cases = {}
+    for name, rs in samples.items():
+        case = dict(rs[0])
+        case["ns_per_op"] = round(statistics.median(r["ns_per_op"] for r in rs), 1)
+        case["ns_min"] = min(r["ns_min"] for r in rs)
+        case["ref_ns"] = round(statistics.median(r["ref_ns"] for r in rs), 1)
+        case["ratio"] = round(statistics.median(r["ratio"] for r in rs), 4)
+        case["allocs_per_op"] = max(r["allocs_per_op"] for r in rs)
+        case["bytes_per_op"] = max(r["bytes_per_op"] for r in rs)
+        case["peak_stack_bytes"] = max(r["peak_stack_bytes"] for r in rs)
+        for key in LATENCY_KEYS:
+            if key in case:
+                values = [r[key] for r in rs]
+                case[key] = max(values) if key == "lat_max_ns" else int(statistics.median(values))
+        cases[name] = case
+    return cases
+
+
+def compare(current: Dict[str, Any], baseline: Dict[str, Any], args: argparse.Namespace) -> List[str]:
+    failures = []
+    same_host = current["host"] == baseline.get("host")
+    check_time = same_host or args.strict_time
+    if not check_time:
+        print("[bench] baseline recorded on a different host/compiler, timing not gated "
+              "(re-record with --update-baseline, or force with --strict-time)", file=sys.stderr)
+
+    for variant, cases in current["variants"].items():
+        base_cases = baseline.get("variants", {}).get(variant, {})
+        for name, cur in cases.items():
+            base = base_cases.get(name)
+            if base is None:
+                print(f"[bench] {variant}/{name}: no baseline", file=sys.stderr)
+                continue
+            tag = f"{variant}/{name}"
+            limit = base["ratio"] * (1.0 + args.threshold)
+            if check_time and cur["ratio"] > limit:
+                failures.append(f"{tag}: ratio {cur['ratio']:.4f} > {limit:.4f} "
+                                f"(baseline {base['ratio']:.4f} +{args.threshold:.0%}, "
+                                f"ns/op {base['ns_per_op']:.1f} -> {cur['ns_per_op']:.1f})")
+            if cur["allocs_per_op"] > base["allocs_per_op"] + 1e-6:
+                failures.append(f"{tag}: allocs_per_op {cur['allocs_per_op']:.3f} > {base['allocs_per_op']:.3f}")
+            if cur["peak_stack_bytes"] > base["peak_stack_bytes"] + args.stack_slack:
+                failures.append(f"{tag}: peak_stack_bytes {cur['peak_stack_bytes']} > "
+                                f"{base['peak_stack_bytes']} + {args.stack_slack}")
+    return failures
+
+
+def print_table(current: Dict[str, Any], baseline: Optional[Dict[str, Any]]) -> None:
+    """delta 为参考负载归一化后相对基线的变化"""
+    print(f"{'variant/case':<36} {'ns/op':>10} {'base':>10} {'delta':>8} {'allocs':>7} {'stack':>6}",
+          file=sys.stderr)
+    for variant, cases in current["variants"].items():
+        base_cases = (baseline or {}).get("variants", {}).get(variant, {})
+        for name, cur in cases.items():
+            base = base_cases.get(name)
+            base_ns = f"{base['ns_per_op']:.1f}" if base else "-"
+            delta = f"{cur['ratio'] / base['ratio'] - 1:+.1%}" if base and base["ratio"] else "-"
+            print(f"{variant + '/' + name:<36} {cur['ns_per_op']:>10.1f} {base_ns:>10} {delta:>8} "
+                  f"{cur['allocs_per_op']:>7.2f} {cur['peak_stack_bytes']:>6}", file=sys.stderr)
+
+    latency = [(variant + "/" + name, cur) for variant, cases in current["variants"].items()
+               for name, cur in cases.items() if "lat_p50_ns" in cur]
+    if latency:
+        print(f"{'per-call latency (ns)':<36} {'p50':>10} {'p90':>10} {'p99':>8} {'max':>14}", file=sys.stderr)
+        for tag, cur in latency:
+            print(f"{tag:<36} {cur['lat_p50_ns']:>10} {cur['lat_p90_ns']:>10} {cur['lat_p99_ns']:>8} "
+                  f"{cur['lat_max_ns']:>14}", file=sys.stderr)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Host benchmark and regression gate for firmware hot paths")
+    parser.add_argument("--cc", default=os.environ.get("CC", "gcc"))
+    parser.add_argument("--cjson", default=os.environ.get("CJSON_DIR", DEFAULT_CJSON_DIR),
+                        help="directory containing cJSON.c/cJSON.h (default: //third_party/cJSON)")
+    parser.add_argument("--variants", default=",".join(VARIANTS), help="comma separated: default,static_mem")
+    parser.add_argument("--filter", help="only run cases whose name contains this string")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE)
+    parser.add_argument("--output", help="write results JSON to this file ('-' for stdout)")
+    parser.add_argument("--runs", type=int, default=3, help="process runs per variant, ns/op takes the median")
+    parser.add_argument("--threshold", type=float, default=0.2, help="allowed ns/op regression ratio")
+    parser.add_argument("--stack-slack", type=int, default=64, help="allowed peak stack growth in bytes")
+    parser.add_argument("--strict-time", action="store_true", help="gate ns/op even if host differs")
+    parser.add_argument("--update-baseline", action="store_true")
+    args = parser.parse_args()
+
+    cjson_dir = os.path.abspath(args.cjson)
+    if not os.path.isfile(os.path.join(cjson_dir, "cJSON.c")):
+        print(f"[bench] cJSON.c not found in {cjson_dir}, pass --cjson or set CJSON_DIR", file=sys.stderr)
+        return 2
+    variants = [v for v in args.variants.split(",") if v]
+    unknown = [v for v in variants if v not in VARIANTS]
+    if unknown:
+        print(f"[bench] unknown variant: {', '.join(unknown)}", file=sys.stderr)
+        return 2
+
+    current = {"schema": 1, "host": host_fingerprint(args.cc), "variants": {}}
+    out_dir = tempfile.mkdtemp(prefix="sl_bench_")
+    try:
+        for variant in variants:
+            binary = build_variant(args.cc, cjson_dir, variant, out_dir)
+            current["variants"][variant] = run_variant(binary, args.filter, max(1, args.runs))
+    except (RuntimeError, ValueError, KeyError) as exc:
+        print(f"[bench] {exc}", file=sys.stderr)
+        return 2
+    finally:
+        shutil.rmtree(out_dir, ignore_errors=True)
+
+    if args.output:
+        text = json.dumps(current, indent=2, ensure_ascii=False) + "\n"
+        if args.output == "-":
+            sys.stdout.write(text)
+        else:
+            with open(args.output, "w", encoding="utf-8") as f:
+                f.write(text)
+
+    baseline = None
+    if os.path.isfile(args.baseline):
+        with open(args.baseline, encoding="utf-8") as f:
+            baseline = json.load(f)
+    print_table(current, baseline)
+
+    if args.update_baseline:
+        with open(args.baseline, "w", encoding="utf-8") as f:
+            json.dump(current, f, indent=2, ensure_ascii=False)
+            f.write("\n")
+        print(f"[bench] baseline written to {os.path.relpath(args.baseline, REPO_ROOT)}", file=sys.stderr)
+        return 0
+    if baseline is None:
+        print("[bench] no baseline, run with --update-baseline first", file=sys.stderr)
+        return 1
+
+    failures = compare(current, baseline, args)
+    for failure in failures:
+        print(f"[bench] REGRESSION {failure}", file=sys.stderr)
+    if failures:
+        return 1
+    print("[bench] all cases within baseline", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,524 @@
+/**
+ * 主机端整机仿真：直接包含 src/smart_laundry.c，以 tools/bench/host 的 pthread 适配层真实运行固件的
+ * 全部任务（循环周期、阻塞点、心跳与监管逻辑与设备上相同），Wi-Fi/MQTT 接入按设定耗时成功。
+ *
+ * 编译（需要 SMART_LAUNDRY_FAULT_INJECT）：
+ *   gcc -O2 -std=gnu99 -DSMART_LAUNDRY_FAULT_INJECT -Itools/bench/host -Isrc -I<cJSON 目录> \
+ *       tools/host_sim.c tools/bench/host/host_os.c src/dryer_logic.c src/dryer_cycle.c src/dryer_trace.c \
+ *       src/dryer_supervisor.c <cJSON 目录>/cJSON.c -lpthread -o host_sim
+ *
+ * 用法：
+ *   host_sim boot [offline]       按设备上典型的 Wi-Fi/DHCP/MQTT 耗时上电一次，输出固件串口日志，
+ *                                 含 net_task 结束时打印的 [boot] 启动阶段表；offline 时网络接入失败
+ *   host_sim hang [trials] [-v]   每个受监管任务分别注入 trials 次软卡死与硬卡死（默认 5 次，至多 20 次），
+ *                                 每次在独立子进程中从上电开始运行固件，注入时刻随机
+ *   host_sim trace [wrap]         运行一个烘干周期（云端启动、按键换档、湿度降到阈值后倒计时停机，DHT11 每 3 次
+ *                                 读取失败 1 次），结束时经下行命令 dump_trace 打印追踪；wrap 时在倒计时中途
+ *                                 连续下发超过 TRACE_CAPACITY 条 set_mode，使追踪环在倒计时中回绕。
+ *                                 输出可直接回放：host_sim trace wrap | trace_replay -
+ *
+ * boot：全部阶段（离线时除 wifi/mqtt/report 外）在 BOOT_REPORT_TIMEOUT_MS 内完成时退出码为0，否则为1。
+ * 软卡死的任务仍响应退出请求，应被单独重建；硬卡死与不可单独重建的任务应触发热重启。
+ * mqtt_send 另做断链注入：MQTTClient_pub 开始失败而 MQTTClient_sub 照常阻塞，应在连续 MQTT_PUB_FAIL_MAX 次
+ * 发布失败后停止心跳并触发热重启，检测时延上界相应加上这几次上报间隔。
+ * 注入前与恢复后的运行期间出现任何重启或热重启均计为误报；另有一个子进程不注入故障运行 SIM_IDLE_MS。
+ * 所有注入的检测时延不超过“心跳期限 + 监管周期”、恢复方式符合预期且无误报时退出码为0，否则为1。
+ * -v 时输出固件串口日志（各子进程交错）。
+ * trace：周期按倒计时停机、未发生热重启（wrap 时环确实在倒计时中回绕）时退出码为0，否则为1；
+ * 追踪内容是否与控制逻辑一致由 trace_replay 判定。
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "host_os.h"
+
+// 固件的 static 函数与全局状态需在同一编译单元内访问
+#include "smart_laundry.c"
+
+#ifndef SMART_LAUNDRY_FAULT_INJECT
+#error "host_sim requires -DSMART_LAUNDRY_FAULT_INJECT"
+#endif
+
+#define SIM_WARMUP_MS 2000U         // 注入前至少运行的时长，覆盖启动与首次上报
+#define SIM_WARMUP_SPAN_MS 3000U    // 注入时刻在预热后随机推迟的范围
+#define SIM_JITTER_MS 20U           // 主机调度抖动余量，计入检测时延上界
+#define SIM_IDLE_MS 30000U
+#define SIM_POLL_MS 1U
+#define SIM_TRIALS_MAX 20U          // 每种注入的最多次数；子进程表静态分配，全静态内存构建同样可用
+#define SIM_BOOT_LIMIT_MS (BOOT_REPORT_TIMEOUT_MS + 5000U)  // 等待 net_task 打印启动阶段表的上限
+#define SIM_CMD_TIMEOUT_MS 5000U    // 等待接收任务取走下行命令的上限，覆盖上电到订阅完成
+#define SIM_TRACE_LIMIT_MS 60000U   // trace 场景等待倒计时停机的上限
+#define SIM_HUM_START 56            // trace 场景的初始湿度，每次读取下降 SIM_HUM_STEP
+#define SIM_HUM_STEP 4
+#define SIM_HUM_FLOOR 36            // 降到阈值以下后在 36/37 之间抖动
+#define SIM_FAIL_EVERY 3U           // 每 3 次读取失败 1 次
+
+typedef enum {
+    SIM_NONE = 0,       // 注入后未检出
+    SIM_RESTARTED,      // 任务被单独重建
+    SIM_REBOOTED,       // 监管触发热重启
+} sim_outcome_t;
+
+typedef struct {
+    int victim;             // 注入的任务，-1 表示不注入
+    int hard;
+    int link;               // 断链注入（仅 mqtt_send）
+    uint32_t hang_after_ms; // 上电后多久注入；不注入时为运行时长
+} sim_trial_t;
+
+typedef struct {
+    uint32_t latency_ms;    // 注入到检出
+    uint32_t recover_ms;    // 检出到重建或热重启
+    int outcome;            // sim_outcome_t
+    uint32_t false_alarms;  // 注入前或恢复后的重启/热重启次数
+} sim_result_t;
+
+typedef struct {
+    pid_t pid;
+    int fd;
+    sim_trial_t trial;
+    sim_result_t result;
+    int ok;                 // 子进程正常写回结果
+} sim_child_t;
+
+static volatile uint32_t g_sim_reboot_ms;   // 热重启请求时刻，0 表示未发生
+static volatile uint32_t g_sim_reads;       // trace 场景的 DHT11 读取次数
+static volatile uint32_t g_sim_read_fails;
+
+/**
+ * @brief hi_soft_reboot 钩子：记录时刻后阻塞监管任务，由主线程汇总结果后结束子进程
+ */
+static void sim_reboot(int cause)
+{
+    (void)cause;
+    uint32_t now = uptime_ms();
+    g_sim_reboot_ms = now ? now : 1;
+    while (1) {
+        pause();
+    }
+}
+
+static void sim_sleep_ms(uint32_t ms)
+{
+    usleep(ms * 1000U);
+}
+
+/**
+ * @brief 上电以来监管采取的恢复动作次数（任务重建与热重启）
+ */
+static uint32_t sim_faults(void)
+{
+    uint32_t faults = g_sim_reboot_ms != 0;
+    for (int i = 0; i < SUP_TASK_COUNT; i++) {
+        faults += g_sup.entries[i].restarts;
+    }
+    return faults;
+}
+
+// 卡死注入：网络接入按设备上的比例缩短，以加快仿真
+static const host_os_config_t g_sim_fast_net = {
+    .threads = 1, .online = 1, .wifi_ms = 50, .dhcp_ms = 50,
+    .mqtt_connect_ms = 20, .mqtt_init_ms = 20, .mqtt_subscribe_ms = 20, .reboot_hook = sim_reboot,
+};
+
+// 启动耗时：Hi3861 关联 2.4G 热点、DHCP 及 IoTDA 建连/鉴权/订阅的典型耗时
+static const host_os_config_t g_sim_device_net = {
+    .threads = 1, .online = 1, .wifi_ms = 2500, .dhcp_ms = 600,
+    .mqtt_connect_ms = 150, .mqtt_init_ms = 250, .mqtt_subscribe_ms = 120, .reboot_hook = sim_reboot,
+};
+
+/**
+ * @brief 以真实任务启动固件
+ */
+static void sim_power_on(const host_os_config_t *net)
+{
+    g_host_os = *net;
+    smart_laundry_demo();
+}
+
+/**
+ * @brief 注入到检出的时延上界：心跳期限 + 监管周期；断链时另加判定断链所需的上报次数
+ */
+static uint32_t sim_bound(const sim_trial_t *trial)
+{
+    uint32_t bound = g_task_desc[trial->victim].deadline_ms + SUP_PERIOD_MS + SIM_JITTER_MS;
+    return trial->link ? bound + MQTT_PUB_FAIL_MAX * MQTT_SEND_INTERVAL_SEC * 1000U : bound;
+}
+
+/**
+ * @brief 子进程中运行一次注入，从上电开始
+ */
+static void sim_run_trial(const sim_trial_t *trial, sim_result_t *result)
+{
+    memset(result, 0, sizeof(*result));
+    result->latency_ms = UINT32_MAX;
+    sim_power_on(&g_sim_fast_net);
+    sim_sleep_ms(trial->hang_after_ms);
+    result->false_alarms = sim_faults();
+    if (trial->victim < 0) {
+        return;
+    }
+
+    const task_desc_t *desc = &g_task_desc[trial->victim];
+    uint32_t limit = sim_bound(trial) + 1000U;
+    uint32_t faults = sim_faults();
+    if (trial->link) {
+        // 断链：发送任务照常循环，只能由连续发布失败检出
+        uint32_t down = uptime_ms();
+        g_host_os.link_down = 1;
+        while (g_sim_reboot_ms == 0 && uptime_ms() - down < limit) {
+            sim_sleep_ms(SIM_POLL_MS);
+        }
+        if (g_sim_reboot_ms != 0) {
+            result->latency_ms = g_sim_reboot_ms - down;
+            result->outcome = SIM_REBOOTED;
+        }
+        return;
+    }
+    (void)inject_hang(desc->name, trial->hard);
+    uint32_t injected = g_inject_at_ms[trial->victim];
+
+    // 检出：监管处理超时任务时清除注入时刻
+    while (g_inject_at_ms[trial->victim] != 0 && uptime_ms() - injected < limit) {
+        sim_sleep_ms(SIM_POLL_MS);
+    }
+    if (g_inject_at_ms[trial->victim] != 0) {
+        return;
+    }
+    uint32_t detected = uptime_ms();
+    if (g_sim_reboot_ms != 0 && g_sim_reboot_ms < detected) {
+        detected = g_sim_reboot_ms;     // 不可单独重建的任务检出后立即热重启
+    }
+    result->latency_ms = detected - injected;
+
+    // 恢复：重建完成（任务句柄重新出现且退出请求已清除）或热重启
+    while (uptime_ms() - detected < SUP_STOP_GRACE_MS + 1000U) {
+        if (g_sim_reboot_ms != 0) {
+            result->outcome = SIM_REBOOTED;
+            result->recover_ms = g_sim_reboot_ms - detected;
+            return;
+        }
+        if (*desc->task_id != NULL && !g_task_stop[trial->victim] && sim_faults() > faults) {
+            result->outcome = SIM_RESTARTED;
+            result->recover_ms = uptime_ms() - detected;
+            break;
+        }
+        sim_sleep_ms(SIM_POLL_MS);
+    }
+    if (result->outcome != SIM_RESTARTED) {
+        return;
+    }
+
+    // 重建后再运行两个心跳期限：重建的任务若未恢复心跳或其他任务受到波及，会再次触发恢复动作
+    faults = sim_faults();
+    sim_sleep_ms(desc->deadline_ms * 2U);
+    result->false_alarms += sim_faults() - faults;
+}
+
+/**
+ * @brief 为一次注入创建子进程，结果经管道写回
+ */
+static int sim_spawn(sim_child_t *child, int verbose)
+{
+    int fds[2];
+
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    fflush(stdout);
+    child->pid = fork();
+    if (child->pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (child->pid == 0) {
+        sim_result_t result;
+        close(fds[0]);
+        if (!verbose) {
+            int null_fd = open("/dev/null", O_WRONLY);
+            if (null_fd >= 0) {
+                dup2(null_fd, STDOUT_FILENO);
+                close(null_fd);
+            }
+        }
+        sim_run_trial(&child->trial, &result);
+        fflush(stdout);
+        _exit(write(fds[1], &result, sizeof(result)) == (ssize_t)sizeof(result) ? 0 : 1);
+    }
+    close(fds[1]);
+    child->fd = fds[0];
+    return 0;
+}
+
+static void sim_collect(sim_child_t *child)
+{
+    child->ok = read(child->fd, &child->result, sizeof(child->result)) == (ssize_t)sizeof(child->result);
+    close(child->fd);
+    kill(child->pid, SIGKILL);  // 固件任务线程不会自行结束
+    waitpid(child->pid, NULL, 0);
+}
+
+static const char *sim_outcome_name(int outcome)
+{
+    switch (outcome) {
+        case SIM_RESTARTED:
+            return "restart";
+        case SIM_REBOOTED:
+            return "reboot";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * @brief 向每个受监管任务注入软/硬卡死，统计检测时延与恢复方式
+ */
+static int sim_hang(int trials, int verbose)
+{
+    int rows = 0;
+    int failed = 0;
+    int count = 0;
+    static sim_child_t children[SUP_TASK_COUNT * 3 * SIM_TRIALS_MAX + 1];
+
+    srand(0x5344);
+    for (int victim = 0; victim < SUP_TASK_COUNT; victim++) {
+        if (g_task_desc[victim].deadline_ms == 0) {
+            continue;   // 不受监管
+        }
+        for (int hard = 0; hard <= (g_task_desc[victim].restartable ? 1 : 0); hard++) {
+            for (int t = 0; t < trials; t++) {
+                sim_child_t *child = &children[count++];
+                child->trial.victim = victim;
+                child->trial.hard = hard;
+                child->trial.hang_after_ms = SIM_WARMUP_MS + (uint32_t)rand() % SIM_WARMUP_SPAN_MS;
+            }
+        }
+        for (int t = 0; victim == SUP_TASK_MQTT_SEND && t < trials; t++) {
+            sim_child_t *child = &children[count++];
+            child->trial.victim = victim;
+            child->trial.link = 1;
+            child->trial.hang_after_ms = SIM_WARMUP_MS + (uint32_t)rand() % SIM_WARMUP_SPAN_MS;
+        }
+    }
+    children[count].trial.victim = -1;
+    children[count].trial.hang_after_ms = SIM_IDLE_MS;
+    count++;
+
+    // 子进程大部分时间在休眠，全部并行运行，总耗时约为最长一次注入
+    for (int i = 0; i < count; i++) {
+        if (sim_spawn(&children[i], verbose) != 0) {
+            fprintf(stderr, "fork failed\n");
+            return 2;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        sim_collect(&children[i]);
+    }
+
+    printf("%-12s %-5s %8s %8s %8s %8s %8s %8s %8s\n", "task", "hang", "deadline", "min", "avg", "max", "bound",
+           "recover", "outcome");
+    for (int i = 0; i < count; i += trials) {
+        const sim_trial_t *trial = &children[i].trial;
+        if (trial->victim < 0) {
+            break;
+        }
+        const task_desc_t *desc = &g_task_desc[trial->victim];
+        sim_outcome_t expect = (desc->restartable && !trial->hard && !trial->link) ? SIM_RESTARTED : SIM_REBOOTED;
+        uint32_t bound = sim_bound(trial);
+        uint32_t min = UINT32_MAX, max = 0, recover = 0, misses = 0, wrong = 0, alarms = 0;
+        uint64_t sum = 0;
+        int n = 0;
+
+        for (int t = 0; t < trials; t++) {
+            const sim_child_t *child = &children[i + t];
+            const sim_result_t *r = &child->result;
+            if (!child->ok || r->latency_ms == UINT32_MAX) {
+                misses++;
+                continue;
+            }
+            n++;
+            sum += r->latency_ms;
+            min = r->latency_ms < min ? r->latency_ms : min;
+            max = r->latency_ms > max ? r->latency_ms : max;
+            recover = r->recover_ms > recover ? r->recover_ms : recover;
+            wrong += r->outcome != (int)expect;
+            alarms += r->false_alarms;
+        }
+        printf("%-12s %-5s %8u %8u %8u %8u %8u %8u %8s", desc->name,
+               trial->link ? "link" : trial->hard ? "hard" : "soft",
+               (unsigned int)desc->deadline_ms, (unsigned int)(n ? min : 0), (unsigned int)(n ? sum / n : 0),
+               (unsigned int)max, (unsigned int)bound, (unsigned int)recover, sim_outcome_name(expect));
+        if (misses || wrong || alarms || max > bound) {
+            printf("  FAIL (misses=%u wrong_outcome=%u false_alarms=%u)", (unsigned int)misses,
+                   (unsigned int)wrong, (unsigned int)alarms);
+            failed = 1;
+        }
+        printf("\n");
+        rows++;
+    }
+
+    const sim_child_t *idle = &children[count - 1];
+    printf("idle %us: %s\n", (unsigned int)(SIM_IDLE_MS / 1000U),
+           !idle->ok ? "FAIL (no result)" : idle->result.false_alarms ? "FAIL (false alarms)" : "no false alarms");
+    failed |= !idle->ok || idle->result.false_alarms != 0;
+    return rows > 0 ? failed : 1;
+}
+
+/**
+ * @brief trace 场景的 DHT11 读数：湿度逐次下降到阈值以下后小幅抖动，周期性读取失败
+ */
+static uint8_t sim_dht11_read(uint8_t *temp, uint8_t *humi)
+{
+    uint32_t n = g_sim_reads++;
+    int hum = SIM_HUM_START - SIM_HUM_STEP * (int)n;
+
+    if (n % SIM_FAIL_EVERY == SIM_FAIL_EVERY - 1U) {
+        g_sim_read_fails++;
+        return 1;
+    }
+    *humi = (uint8_t)(hum > SIM_HUM_FLOOR ? hum : SIM_HUM_FLOOR + (int)(n & 1U));
+    *temp = (uint8_t)(30U + n / 4U);
+    return 0;
+}
+
+/**
+ * @brief 经接收任务下发一条云端命令并等待处理完成
+ */
+static int sim_command(const char *name, const char *paras)
+{
+    static unsigned int request;
+    char topic[MQTT_TOPIC_BUF_SIZE];
+    char payload[96];
+
+    snprintf(topic, sizeof(topic), "$oc/devices/%s/sys/commands/request_id=sim-%u", DEVICE_ID, request++);
+    snprintf(payload, sizeof(payload), "{\"command_name\":\"%s\",\"paras\":%s}", name, paras);
+    if (host_mqtt_deliver(topic, payload, SIM_CMD_TIMEOUT_MS) != 0) {
+        printf("[sim] command %s not delivered\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 运行一个烘干周期并导出追踪；wrap 时在倒计时中途灌入命令使追踪环回绕
+ */
+static int sim_trace(int wrap)
+{
+    host_os_config_t net = g_sim_fast_net;
+    dryer_state_t snap;
+    char paras[24];
+    uint32_t waited = 0;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    net.dht11_read = sim_dht11_read;
+    sim_power_on(&net);
+    if (sim_command("start", "{}") != 0) {
+        return 1;
+    }
+    sim_sleep_ms(SENSOR_PERIOD_MS);
+    g_host_os.key_press = KEY2_PRESS;   // 换档：按键记录与状态记录
+
+    if (wrap) {
+        // 倒计时过半时灌入不改变档位的 set_mode：每条只产生一条云端记录，倒计时开始后的采样全部被覆盖
+        do {
+            sim_sleep_ms(10);
+            waited += 10;
+            snap = get_state_snapshot();
+        } while ((snap.countdown < 0 || snap.countdown > COUNTDOWN_SECONDS / 2) && snap.running &&
+                 waited < SIM_TRACE_LIMIT_MS);
+        snprintf(paras, sizeof(paras), "{\"gear\":%d}", (int)snap.mode + 1);
+        for (uint32_t i = 0; i < TRACE_CAPACITY + TRACE_CAPACITY / 8U; i++) {
+            if (sim_command("set_mode", paras) != 0) {
+                return 1;
+            }
+        }
+        snap = get_state_snapshot();
+        if (!snap.running || snap.countdown < 0 || dryer_trace_count() <= TRACE_CAPACITY) {
+            printf("[sim] ring did not wrap during the countdown (running=%d countdown=%d records=%u)\n",
+                   snap.running, snap.countdown, (unsigned int)dryer_trace_count());
+            return 1;
+        }
+        printf("[sim] ring wrapped at countdown=%d\n", snap.countdown);
+    }
+
+    while (get_state_snapshot().running && waited < SIM_TRACE_LIMIT_MS) {
+        sim_sleep_ms(10);
+        waited += 10;
+    }
+    snap = get_state_snapshot();
+    if (sim_command("dump_trace", "{}") != 0) {
+        return 1;
+    }
+    printf("[sim] reads=%u failures=%u records=%u%s\n", (unsigned int)g_sim_reads, (unsigned int)g_sim_read_fails,
+           (unsigned int)dryer_trace_count(), snap.running ? " (dryer still running)" : "");
+    return (snap.running || g_sim_reboot_ms != 0) ? 1 : 0;
+}
+
+/**
+ * @brief 上电一次并等待 net_task 打印启动阶段表与内存报告
+ */
+static int sim_boot(int offline)
+{
+    host_os_config_t net = g_sim_device_net;
+    uint32_t waited = 0;
+    int missing = 0;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);   // 与固件线程的日志按行交错
+    net.online = !offline;
+    printf("[sim] wifi=%ums dhcp=%ums mqtt connect=%ums init=%ums subscribe=%ums%s\n",
+           (unsigned int)net.wifi_ms, (unsigned int)net.dhcp_ms, (unsigned int)net.mqtt_connect_ms,
+           (unsigned int)net.mqtt_init_ms, (unsigned int)net.mqtt_subscribe_ms, offline ? " (offline)" : "");
+    sim_power_on(&net);
+    while (osThreadGetState(g_net_task_id) != osThreadTerminated && waited < SIM_BOOT_LIMIT_MS) {
+        sim_sleep_ms(10);
+        waited += 10;
+    }
+    if (osThreadGetState(g_net_task_id) != osThreadTerminated) {
+        printf("[sim] net_boot did not finish within %ums\n", (unsigned int)SIM_BOOT_LIMIT_MS);
+        return 1;
+    }
+    for (int i = 0; i < BOOT_PHASE_MAX; i++) {
+        int net_phase = i == BOOT_PHASE_WIFI || i == BOOT_PHASE_MQTT || i == BOOT_PHASE_REPORT;
+        if (g_boot_ms[i] == 0 && !(offline && net_phase)) {
+            printf("[sim] boot phase %s not reached\n", g_boot_phase_name[i]);
+            missing++;
+        }
+    }
+    return (missing != 0 || g_sim_reboot_ms != 0) ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = argc > 1 ? argv[1] : "";
+    int verbose = 0;
+    int trials = 5;
+
+    if (strcmp(mode, "trace") == 0) {
+        return sim_trace(argc > 2 && strcmp(argv[2], "wrap") == 0);
+    }
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        } else {
+            trials = atoi(argv[i]);
+        }
+    }
+    if (strcmp(mode, "boot") == 0) {
+        return sim_boot(argc > 2 && strcmp(argv[2], "offline") == 0);
+    }
+    if (strcmp(mode, "hang") == 0 && trials > 0 && trials <= (int)SIM_TRIALS_MAX) {
+        return sim_hang(trials, verbose);
+    }
+    fprintf(stderr, "usage: %s boot [offline] | hang [trials] [-v] | trace [wrap]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+静态 RAM 占用报告：读取编译产物（静态库或目标文件）的符号表，按目标文件汇总
+.data/.bss 等常驻 SRAM 的符号尺寸，并检查应用源文件是否引用堆分配函数。
+
+用法：
+  python3 tools/ram_report.py libSmartLaundry.a
+  python3 tools/ram_report.py --nm riscv32-unknown-elf-nm --output ram.txt libSmartLaundry.a
+  python3 tools/ram_report.py --top 10 smart_laundry.o dryer_trace.o
+
+判定规则（任一项不满足退出码为 1，读取符号表失败为 2）：
+  - 应用目标文件（smart_laundry*、dryer_*）的 RAM 合计不超过 SL_RAM_BUDGET
+    （默认取 src/smart_laundry_mem.h 中的定义，可用 --budget 覆盖）
+  - 应用目标文件不引用 malloc/calloc/realloc/free 等堆函数；BSP 与第三方库的引用只提示
+"""
+
+import argparse
+import ast
+import operator
+import os
+import re
+import subprocess
+import sys
+from typing import Dict, List, Tuple
+
+REPO_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+MEM_HEADER = os.path.join(REPO_ROOT, "src", "smart_laundry_mem.h")
+# nm 符号类型：b/B .bss，d/D .data，s/S/g/G 小数据段，C 公共符号，v/V 弱对象
+RAM_TYPES = set("bBdDsSgGCvV")
+HEAP_SYMBOLS = {"malloc", "calloc", "realloc", "free", "zalloc",
+                "LOS_MemAlloc", "LOS_MemAllocAlign", "LOS_MemRealloc", "LOS_MemFree",
+                "hi_malloc", "hi_free"}
+APP_OBJECT = re.compile(r"^(smart_laundry|dryer_)")
+_OPS = {ast.Add: operator.add, ast.Sub: operator.sub, ast.Mult: operator.mul, ast.FloorDiv: operator.floordiv}
+
+
+def _eval_int(node: ast.AST) -> int:
+    if isinstance(node, ast.Constant) and isinstance(node.value, int):
+        return node.value
+    if isinstance(node, ast.BinOp) and type(node.op) in _OPS:
+        return _OPS[type(node.op)](_eval_int(node.left), _eval_int(node.right))
+    raise ValueError("unsupported expression")
+
+
+def header_budget(path: str) -> int:
+    """解析头文件中的 SL_RAM_BUDGET（仅支持整数四则运算）"""
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            m = re.match(r"\s*#define\s+SL_RAM_BUDGET\s+(.+?)\s*(//.*)?$", line)
+            if m:
+                expr = re.sub(r"(\d+)[uUlL]+", r"\1", m.group(1)).replace("/", "//")
+                return _eval_int(ast.parse(expr, mode="eval").body)
+    raise ValueError(f"SL_RAM_BUDGET not found in {path}")
+
+
+def read_symbols(nm: str, files: List[str]) -> Tuple[Dict[str, List[Tuple[str, str, int]]], Dict[str, List[str]]]:
+    """返回 {目标文件: [(符号, 类型, 字节)]} 与 {目标文件: [未定义符号]}"""
+    proc = subprocess.run([nm, "-S", "-t", "d", "-A", *files], capture_output=True, text=True)
+    if proc.returncode != 0:
+        raise RuntimeError(proc.stderr.strip() or f"{nm} exited with {proc.returncode}")
+    defined: Dict[str, List[Tuple[str, str, int]]] = {}
+    undefined: Dict[str, List[str]] = {}
+    for line in proc.stdout.splitlines():
+        # 静态库为 "lib.a:member.o:值 尺寸 类型 名称"，目标文件为 "file.o:..."；未定义符号没有值与尺寸
+        head, _, rest = line.rpartition(":")
+        if not head:
+            continue
+        obj = os.path.basename(head.split(":")[-1])
+        fields = rest.split()
+        if len(fields) == 2 and fields[0] == "U":
+            undefined.setdefault(obj, []).append(fields[1])
+        elif len(fields) == 4 and fields[2] in RAM_TYPES:
+            defined.setdefault(obj, []).append((fields[3], fields[2], int(fields[1])))
+        else:
+            defined.setdefault(obj, [])
+    return defined, undefined
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Static RAM usage and heap reference report")
+    parser.add_argument("inputs", nargs="+", help="static library or object files")
+    parser.add_argument("--nm", default=os.environ.get("NM", "nm"))
+    parser.add_argument("--budget", type=int, help="RAM budget in bytes (default: SL_RAM_BUDGET)")
+    parser.add_argument("--top", type=int, default=5, help="largest symbols listed per object")
+    parser.add_argument("--output", help="also write the report to this file")
+    args = parser.parse_args()
+
+    try:
+        budget = args.budget if args.budget is not None else header_budget(MEM_HEADER)
+        defined, undefined = read_symbols(args.nm, args.inputs)
+    except (OSError, RuntimeError, ValueError) as exc:
+        print(f"[ram] {exc}", file=sys.stderr)
+        return 2
+
+    lines = [f"{'object':<32} {'data':>7} {'bss':>7} {'total':>7}  largest"]
+    app_total = other_total = 0
+    for obj in sorted(defined, key=lambda o: (not APP_OBJECT.match(o), o)):
+        syms = defined[obj]
+        data = sum(size for _, kind, size in syms if kind in "dDgG")
+        total = sum(size for _, _, size in syms)
+        largest = ", ".join(f"{name}={size}" for name, _, size in sorted(syms, key=lambda s: -s[2])[:args.top])
+        lines.append(f"{obj:<32} {data:>7} {total - data:>7} {total:>7}  {largest}")
+        if APP_OBJECT.match(obj):
+            app_total += total
+        else:
+            other_total += total
+    lines.append(f"{'application':<32} {'':>7} {'':>7} {app_total:>7}  budget={budget} free={budget - app_total}")
+    lines.append(f"{'bsp/third party':<32} {'':>7} {'':>7} {other_total:>7}")
+
+    failures = []
+    if app_total > budget:
+        failures.append(f"application static RAM {app_total} exceeds SL_RAM_BUDGET {budget}")
+    for obj in sorted(undefined):
+        heap = sorted(HEAP_SYMBOLS.intersection(undefined[obj]))
+        if not heap:
+            continue
+        if APP_OBJECT.match(obj):
+            failures.append(f"{obj} references heap: {', '.join(heap)}")
+        else:
+            lines.append(f"[ram] note: {obj} references heap: {', '.join(heap)}")
+
+    report = "\n".join(lines) + "\n"
+    sys.stdout.write(report)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(report)
+            for failure in failures:
+                f.write(f"FAIL {failure}\n")
+    for failure in failures:
+        print(f"[ram] FAIL {failure}", file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
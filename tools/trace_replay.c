@@ -0,0 +1,385 @@
+/**
+ * 烘干事件追踪回放工具（主机端）：将设备导出的追踪记录在虚拟时钟上重新送入
+ * dryer_logic 的控制逻辑，逐条核对状态提交，复现现场提前/延后停机问题。
+ *
+ * 编译：gcc -O2 -std=c99 -Isrc tools/trace_replay.c src/dryer_logic.c -o trace_replay
+ *
+ * 用法：
+ *   trace_replay <trace.txt|->       回放追踪文件（串口 dump_trace 日志或按序号拉取的 get_trace data 拼接）
+ *   trace_replay --synth <minutes> [--noise <amp>]  生成指定时长的模拟烘干周期并回放，用于性能与回归检查；
+ *                                                   --noise 叠加 ±amp 的温湿度抖动，检查带噪声的周期能否装入设备环形缓冲区
+ *   trace_replay --emit <minutes> [--noise <amp>]   仅输出模拟周期的追踪十六进制串
+ *
+ * 输入中以 "[trace] " 开头的行取其后内容，其余行须为纯十六进制，否则忽略；
+ * "[trace] begin" 与 "[trace] lost" 行丢弃此前读入的记录，从设备重新给出的基准状态开始。
+ * 环回绕后的导出以基准状态开头，设备已按同样的规则推进了被覆盖的记录，倒计时中回绕也可逐条核对；
+ * 整机仿真 tools/host_sim.c 的 trace 模式输出真实任务运行的串口日志，可直接交给本工具回放。
+ * 所有状态提交与回放结果一致时退出码为0，否则为1。
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dryer_logic.h"
+#include "dryer_trace.h"
+#include "smart_laundry_mem.h"
+
+#define LINE_MAX_LEN 4096
+#define MISMATCH_PRINT_MAX 10
+
+typedef struct {
+    dryer_trace_rec_t *recs;
+    size_t len;
+    size_t cap;
+} trace_t;
+
+typedef struct {
+    size_t records;
+    size_t samples;
+    size_t inputs;
+    size_t failures;          // DHT11 读取失败次数（合并记录按 b 累加）
+    size_t checks;
+    size_t mismatches;
+    uint32_t start_ms;
+    uint32_t end_ms;
+    uint32_t stop_ms;         // 倒计时停机时刻，0 表示未发生
+    dryer_state_t final;
+} replay_result_t;
+
+static int trace_push(trace_t *trace, const dryer_trace_rec_t *rec)
+{
+    if (trace->len == trace->cap) {
+        size_t cap = trace->cap ? trace->cap * 2 : 1024;
+        dryer_trace_rec_t *recs = realloc(trace->recs, cap * sizeof(*recs));
+        if (recs == NULL) {
+            return -1;
+        }
+        trace->recs = recs;
+        trace->cap = cap;
+    }
+    trace->recs[trace->len++] = *rec;
+    return 0;
+}
+
+static int hex_value(int c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c = tolower(c);
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief 读取十六进制追踪文本
+ * @return 成功返回0，失败返回-1
+ */
+static int trace_load(FILE *fp, trace_t *trace)
+{
+    char line[LINE_MAX_LEN];
+    uint8_t raw[DRYER_TRACE_REC_SIZE];
+    size_t nraw = 0;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        const char *p = strstr(line, "[trace] ");
+        p = p != NULL ? p + strlen("[trace] ") : line;
+        if (strncmp(p, "begin", 5) == 0 || strncmp(p, "lost", 4) == 0) {
+            // 新的一次导出，或设备在导出期间覆盖了未读记录并从基准状态重新开始
+            trace->len = 0;
+            nraw = 0;
+            continue;
+        }
+
+        // 整行须为十六进制（允许行尾空白），否则视为日志或 begin/end 标记
+        size_t n = strcspn(p, "\r\n");
+        int valid = n > 0;
+        for (size_t i = 0; i < n && valid; i++) {
+            valid = hex_value((unsigned char)p[i]) >= 0 || isspace((unsigned char)p[i]);
+        }
+        if (!valid) {
+            continue;
+        }
+
+        int hi = -1;
+        for (size_t i = 0; i < n; i++) {
+            int v = hex_value((unsigned char)p[i]);
+            if (v < 0) {
+                continue;
+            }
+            if (hi < 0) {
+                hi = v;
+                continue;
+            }
+            raw[nraw++] = (uint8_t)((hi << 4) | v);
+            hi = -1;
+            if (nraw == DRYER_TRACE_REC_SIZE) {
+                dryer_trace_rec_t rec;
+                dryer_trace_decode(raw, &rec);
+                if (trace_push(trace, &rec) != 0) {
+                    return -1;
+                }
+                nraw = 0;
+            }
+        }
+    }
+    if (nraw != 0) {
+        fprintf(stderr, "warning: %zu trailing bytes ignored\n", nraw);
+    }
+    return 0;
+}
+
+/**
+ * @brief 与设备端记录器一致的追加规则：等价采样与连续读取失败合并（dryer_trace_merge），状态仅在变化时记录
+ */
+static int synth_record(trace_t *trace, uint32_t ts, trace_evt_t type, uint8_t a, int16_t b)
+{
+    dryer_trace_rec_t *last = trace->len > 0 ? &trace->recs[trace->len - 1] : NULL;
+    dryer_trace_rec_t *prev = trace->len > 1 ? &trace->recs[trace->len - 2] : NULL;
+    if (dryer_trace_merge(prev, last, (uint8_t)type, a)) {
+        return 0;
+    }
+    dryer_trace_rec_t rec = {.ts_ms = ts, .type = (uint8_t)type, .a = a, .b = b};
+    return trace_push(trace, &rec);
+}
+
+/**
+ * @brief 模拟传感器抖动：返回 [-amp, amp] 内的伪随机整数，序列固定便于复现
+ */
+static int synth_noise(uint32_t *seed, int amp)
+{
+    if (amp <= 0) {
+        return 0;
+    }
+    *seed = *seed * 1103515245U + 12345U;
+    return (int)((*seed >> 16) % (uint32_t)(2 * amp + 1)) - amp;
+}
+
+static int synth_state(trace_t *trace, uint32_t ts, const dryer_state_t *state, int *last_code)
+{
+    int code = dryer_trace_state_code(state);
+    if (code == *last_code) {
+        return 0;
+    }
+    *last_code = code;
+    return synth_record(trace, ts, TRACE_EVT_STATE, (uint8_t)code, (int16_t)state->countdown);
+}
+
+/**
+ * @brief 生成模拟烘干周期：云端启动后湿度从 85% 线性降至 35%，到阈值后倒计时停机
+ * @param noise 温湿度叠加的抖动幅度（%RH / ℃），0 为理想曲线；DHT11 实测约为 1
+ *
+ * 有抖动时湿度在阈值附近反复穿越，倒计时会被多次重置，与现场行为一致
+ */
+static int trace_synth(trace_t *trace, uint32_t minutes, int noise)
+{
+    dryer_state_t state = {.running = 0, .mode = DRY_MODE_STANDARD, .countdown = -1};
+    uint32_t samples = minutes * 60U * (1000U / SENSOR_PERIOD_MS);
+    uint32_t seed = 1;
+    int last_code = -1;
+    uint32_t ts = 0;
+
+    if (samples == 0) {
+        return -1;
+    }
+    synth_record(trace, ts, TRACE_EVT_BOOT, DRYER_TRACE_VERSION, 0);
+    synth_state(trace, ts, &state, &last_code);
+
+    ts += SENSOR_PERIOD_MS;
+    synth_record(trace, ts, TRACE_EVT_CLOUD, DRYER_INPUT_START, 0);
+    dryer_apply_input(&state, DRYER_INPUT_START, 0);
+    synth_state(trace, ts, &state, &last_code);
+
+    // 有抖动时湿度曲线在阈值附近停留更久，多留出一段采样让倒计时有机会完成
+    uint32_t limit = noise > 0 ? samples + samples / 4U : samples;
+    for (uint32_t i = 0; i < limit && state.running; i++) {
+        ts += SENSOR_PERIOD_MS;
+        uint32_t k = i < samples ? i : samples;
+        uint8_t hum = (uint8_t)((int)(85U - (50U * k) / samples) + synth_noise(&seed, noise));
+        uint8_t temp = (uint8_t)((int)(30U + (12U * k) / samples) + synth_noise(&seed, noise));
+        if (synth_record(trace, ts, TRACE_EVT_SENSOR, hum, temp) != 0) {
+            return -1;
+        }
+        (void)dryer_sensor_step(&state, temp, hum);
+        if (synth_state(trace, ts, &state, &last_code) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void print_state(const char *tag, uint32_t ts, const dryer_state_t *state)
+{
+    printf("  %-8s t=%8.3fs running=%d mode=%s countdown=%d\n", tag, ts / 1000.0, state->running,
+           mode_to_string(state->mode), state->countdown);
+}
+
+/**
+ * @brief 在虚拟时钟上回放追踪记录
+ *
+ * 回放从第一条状态记录开始；合并的重复采样按 SENSOR_PERIOD_MS 展开
+ */
+static void trace_replay(const trace_t *trace, replay_result_t *res)
+{
+    dryer_state_t state = {0};
+    int synced = 0;
+
+    memset(res, 0, sizeof(*res));
+    for (size_t i = 0; i < trace->len; i++) {
+        const dryer_trace_rec_t *rec = &trace->recs[i];
+
+        if (!synced) {
+            if (rec->type != TRACE_EVT_STATE) {
+                continue;
+            }
+            state.running = rec->a & 1U;
+            state.mode = (dry_mode_t)(rec->a >> 1);
+            state.countdown = rec->b;
+            res->start_ms = rec->ts_ms;
+            synced = 1;
+            res->records++;
+            continue;
+        }
+
+        res->records++;
+        res->end_ms = rec->ts_ms;
+        switch (rec->type) {
+            case TRACE_EVT_SENSOR: {
+                uint16_t b = (uint16_t)rec->b;
+                uint32_t repeat = (b >> 8) + 1U;
+                for (uint32_t k = 0; k < repeat; k++) {
+                    uint32_t vclock = rec->ts_ms + k * SENSOR_PERIOD_MS;
+                    if (dryer_sensor_step(&state, (uint8_t)(b & 0xFFU), rec->a)) {
+                        res->stop_ms = vclock;
+                    }
+                    res->end_ms = vclock;
+                    res->samples++;
+                }
+                break;
+            }
+            case TRACE_EVT_SENSOR_FAIL:
+                res->failures += rec->b > 0 ? (size_t)rec->b : 1U;  // 版本 1 的记录不带次数
+                break;
+            case TRACE_EVT_KEY:
+            case TRACE_EVT_CLOUD:
+                dryer_apply_input(&state, (dryer_input_t)rec->a, rec->b);
+                res->inputs++;
+                break;
+            case TRACE_EVT_STATE: {
+                dryer_state_t expect = state;
+                expect.running = rec->a & 1U;
+                expect.mode = (dry_mode_t)(rec->a >> 1);
+                expect.countdown = rec->b;
+                res->checks++;
+                if (dryer_trace_state_code(&expect) != dryer_trace_state_code(&state) ||
+                    expect.countdown != state.countdown) {
+                    if (res->mismatches < MISMATCH_PRINT_MAX) {
+                        printf("mismatch #%zu at record %zu:\n", res->mismatches + 1, i);
+                        print_state("device", rec->ts_ms, &expect);
+                        print_state("replay", rec->ts_ms, &state);
+                    }
+                    res->mismatches++;
+                    state = expect;  // 以设备状态为准继续回放，定位后续偏差
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    res->final = state;
+}
+
+static void trace_emit(const trace_t *trace)
+{
+    uint8_t raw[DRYER_TRACE_REC_SIZE];
+
+    printf("[trace] begin v%d records=%zu\n", DRYER_TRACE_VERSION, trace->len);
+    for (size_t i = 0; i < trace->len; i++) {
+        if (i % 16 == 0) {
+            printf("%s[trace] ", i ? "\n" : "");
+        }
+        dryer_trace_encode(&trace->recs[i], raw);
+        for (int j = 0; j < DRYER_TRACE_REC_SIZE; j++) {
+            printf("%02x", raw[j]);
+        }
+    }
+    printf("\n[trace] end\n");
+}
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    trace_t trace = {0};
+    replay_result_t res;
+    struct timespec t0;
+    struct timespec t1;
+
+    int synth = argc >= 3 && (strcmp(argv[1], "--synth") == 0 || strcmp(argv[1], "--emit") == 0);
+    int noise = 0;
+    if (synth && argc == 5 && strcmp(argv[3], "--noise") == 0) {
+        noise = atoi(argv[4]);
+    } else if (argc != 2 && !(synth && argc == 3)) {
+        fprintf(stderr, "usage: %s <trace.txt|-> | --synth <minutes> [--noise <amp>] | --emit <minutes> [--noise <amp>]\n",
+                argv[0]);
+        return 2;
+    }
+
+    if (synth) {
+        if (trace_synth(&trace, (uint32_t)strtoul(argv[2], NULL, 10), noise) != 0) {
+            fprintf(stderr, "synth failed\n");
+            return 2;
+        }
+        if (strcmp(argv[1], "--emit") == 0) {
+            trace_emit(&trace);
+            free(trace.recs);
+            return 0;
+        }
+        if (trace.len > TRACE_CAPACITY) {
+            // 设备环形缓冲区装不下整个周期，现场只能回放周期的后段
+            fprintf(stderr, "warning: %zu records exceed the device ring of %d\n", trace.len, TRACE_CAPACITY);
+        }
+    } else {
+        FILE *fp = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "r");
+        if (fp == NULL) {
+            perror(argv[1]);
+            return 2;
+        }
+        int ret = trace_load(fp, &trace);
+        if (fp != stdin) {
+            fclose(fp);
+        }
+        if (ret != 0) {
+            fprintf(stderr, "out of memory\n");
+            return 2;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    trace_replay(&trace, &res);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    printf("records=%zu replayed=%zu samples=%zu failures=%zu inputs=%zu checks=%zu mismatches=%zu\n", trace.len,
+           res.records, res.samples, res.failures, res.inputs, res.checks, res.mismatches);
+    printf("virtual span=%.1fs", (res.end_ms - res.start_ms) / 1000.0);
+    if (res.stop_ms != 0) {
+        printf(" countdown stop at t=%.1fs", res.stop_ms / 1000.0);
+    }
+    printf("\n");
+    print_state("final", res.end_ms, &res.final);
+    printf("replay time=%.3fms\n", elapsed_ms(&t0, &t1));
+
+    free(trace.recs);
+    return res.mismatches == 0 ? 0 : 1;
+}
@@ -3,8 +3,13 @@ Flask + 华为云 IoTDA 官方 SDK（北向）：命令下发 & 影子查询。
 Hardcoded credentials for testing.
 """
 
+import bisect
+import datetime
+import json
+import os
+import threading
 import time
-from typing import Any, Dict
+from typing import Any, Dict, List, Optional, Tuple
 
 from flask import Flask, jsonify, request, send_from_directory, redirect, session
 from flask_cors import CORS
@@ -28,6 +33,13 @@ REGION_ID = "cn-north-4"
 LOGIN_USERNAME = "admin"  # 简单用户名（测试用）
 LOGIN_PASSWORD = "admin123"  # 简单登录密码（测试用）
 SECRET_KEY = "smart-laundry-secret"
+CYCLE_STORE_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data", "cycles.jsonl")
+INGEST_TOKEN = "smart-laundry-ingest"  # IoTDA 数据转发（HTTP 推送）调用 /api/cycles 时携带
+HISTORY_MAX_ITEMS = 1000
+IOTDA_TIME_FORMAT = "%Y%m%dT%H%M%SZ"  # IoTDA 推送消息中的 event_time，UTC
+CYCLE_REQUIRED_INTS = ("seq", "duration", "motor_on")  # cycle_summary 必填的非负整数字段
+CYCLE_OPTIONAL_INTS = ("hum_start", "hum_end", "ended_ago")
+CYCLE_STRINGS = ("start", "stop", "mode")
 
 print("=" * 50)
 print("           IoTDA Flask Web 服务配置")
@@ -78,6 +90,230 @@ def iotda_send_command(command_name: str, paras: Dict[str, Any]) -> Dict[str, An
     return resp.to_dict()
 
 
+def as_count(value: Any) -> Optional[int]:
+    """非负整数（允许整数值的浮点数），其他类型与布尔值返回 None。"""
+    if isinstance(value, bool) or not isinstance(value, (int, float)):
+        return None
+    if value != value or value < 0 or value != int(value):
+        return None
+    return int(value)
+
+
+def validate_cycle(paras: Dict[str, Any]) -> Tuple[Optional[Dict[str, Any]], str]:
+    """校验并规范化一条 cycle_summary：数值字段转为整数，返回 (记录, "") 或 (None, 错误说明)。"""
+    record = dict(paras)
+    for name in CYCLE_REQUIRED_INTS + CYCLE_OPTIONAL_INTS:
+        if name not in paras:
+            if name in CYCLE_REQUIRED_INTS:
+                return None, f"missing {name}"
+            continue
+        value = as_count(paras[name])
+        if value is None:
+            return None, f"{name} must be a non-negative integer"
+        record[name] = value
+    for name in CYCLE_STRINGS:
+        if name in paras and not isinstance(paras[name], str):
+            return None, f"{name} must be a string"
+    if "hist" in paras:
+        hist = paras["hist"]
+        if not isinstance(hist, list) or any(as_count(v) is None for v in hist):
+            return None, "hist must be a list of non-negative integers"
+        record["hist"] = [as_count(v) for v in hist]
+    return record, ""
+
+
+class CycleStore:
+    """烘干周期汇总的只追加存储：每行一条 JSON，内存中保存按周期结束时间 ts 排序的 (ts, 文件偏移) 索引，按时间范围二分定位。
+    离线补报的周期可能晚于更新的周期到达，文件按到达顺序追加，索引按 ts 插入到对应位置。
+    索引同时保存每条记录的 duration/motor_on，时间范围内的合计不受返回条数限制，也不需要读文件。"""
+
+    def __init__(self, path: str) -> None:
+        self.path = path
+        self.lock = threading.Lock()
+        self.ts_index: List[float] = []
+        self.offsets: List[int] = []
+        self.durations: List[int] = []
+        self.motor_on: List[int] = []
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        self._load_index()
+
+    @staticmethod
+    def _line_meta(line: bytes) -> Optional[Tuple[float, int, int]]:
+        """(ts, duration, motor_on)；早期未经校验写入的记录中非数值的时长按 0 计。"""
+        try:
+            entry = json.loads(line)
+            ts = float(entry["ts"])
+        except (ValueError, KeyError, TypeError):
+            return None
+        return ts, as_count(entry.get("duration")) or 0, as_count(entry.get("motor_on")) or 0
+
+    def _insert(self, pos: int, meta: Tuple[float, int, int], offset: int) -> None:
+        self.ts_index.insert(pos, meta[0])
+        self.offsets.insert(pos, offset)
+        self.durations.insert(pos, meta[1])
+        self.motor_on.insert(pos, meta[2])
+
+    def _load_index(self) -> None:
+        if not os.path.exists(self.path):
+            return
+        offset = 0
+        tail = b""
+        rows = []
+        with open(self.path, "rb") as fp:
+            for line in fp:
+                if not line.endswith(b"\n"):
+                    tail = line  # 写入中断留下的尾行
+                    break
+                meta = self._line_meta(line)
+                if meta is not None:
+                    rows.append((meta, offset))
+                offset += len(line)
+        if tail:
+            # 不处理的话下一次追加会接在残行后面，两条记录都无法解析
+            with open(self.path, "r+b") as fp:
+                meta = self._line_meta(tail)
+                if meta is None:
+                    fp.truncate(offset)
+                else:
+                    fp.seek(offset + len(tail))
+                    fp.write(b"\n")
+                    rows.append((meta, offset))
+        rows.sort(key=lambda row: (row[0][0], row[1]))
+        self.ts_index = [meta[0] for meta, _ in rows]
+        self.offsets = [offset for _, offset in rows]
+        self.durations = [meta[1] for meta, _ in rows]
+        self.motor_on = [meta[2] for meta, _ in rows]
+
+    def append(self, record: Dict[str, Any], ts: float) -> Dict[str, Any]:
+        with self.lock:
+            entry = dict(record, ts=ts)
+            line = (json.dumps(entry, ensure_ascii=False, separators=(",", ":")) + "\n").encode("utf-8")
+            with open(self.path, "ab") as fp:
+                offset = fp.tell()
+                try:
+                    fp.write(line)
+                    fp.flush()
+                except OSError:
+                    fp.truncate(offset)  # 不留半行
+                    raise
+            pos = bisect.bisect_right(self.ts_index, ts)
+            self._insert(pos, (ts, entry["duration"], entry["motor_on"]), offset)
+            return entry
+
+    def query(self, start: float, end: float, limit: int) -> Tuple[List[Dict[str, Any]], Dict[str, int]]:
+        """返回时间范围内最早的 limit 条记录，以及整个范围的合计（cycles/duration/motor_on）。"""
+        with self.lock:
+            lo = bisect.bisect_left(self.ts_index, start)
+            end_pos = bisect.bisect_right(self.ts_index, end)
+            hi = min(end_pos, lo + limit)
+            offsets = self.offsets[lo:hi]
+            totals = {
+                "cycles": max(0, end_pos - lo),
+                "duration": sum(self.durations[lo:end_pos]),
+                "motor_on": sum(self.motor_on[lo:end_pos]),
+            }
+        items = []
+        with open(self.path, "rb") as fp:
+            for offset in offsets:
+                fp.seek(offset)
+                try:
+                    items.append(json.loads(fp.readline()))
+                except ValueError:
+                    continue  # 损坏的行跳过，不让一条坏记录使整个查询失败
+        return items, totals
+
+
+cycle_store = CycleStore(CYCLE_STORE_PATH)
+
+
+def parse_iotda_time(value: Any) -> Optional[float]:
+    """解析 IoTDA 的 event_time（yyyyMMdd'T'HHmmss'Z'），无法解析返回 None。"""
+    if not isinstance(value, str):
+        return None
+    try:
+        return datetime.datetime.strptime(value, IOTDA_TIME_FORMAT).replace(tzinfo=datetime.timezone.utc).timestamp()
+    except ValueError:
+        return None
+
+
+def extract_cycle_summaries(data: Any) -> List[Tuple[Dict[str, Any], Optional[float]]]:
+    """兼容 IoTDA 数据转发的事件消息（notify_data.body.services）、设备上报格式（services）与裸 paras。
+    返回 (paras, 事件时间)；事件时间取服务项的 event_time，其次推送消息的 event_time，都没有时为 None。"""
+    if not isinstance(data, dict):
+        return []
+    msg_time = parse_iotda_time(data.get("event_time"))
+    body = data.get("notify_data", {}).get("body", data) if isinstance(data.get("notify_data"), dict) else data
+    services = body.get("services") if isinstance(body, dict) else None
+    if isinstance(services, list):
+        return [(s["paras"], parse_iotda_time(s.get("event_time")) or msg_time) for s in services
+                if isinstance(s, dict) and s.get("event_type") == "cycle_summary" and isinstance(s.get("paras"), dict)]
+    return [(body, msg_time)] if isinstance(body, dict) and "seq" in body else []
+
+
+def cycle_end_time(paras: Dict[str, Any], event_time: Optional[float], received: float) -> Tuple[float, str]:
+    """周期结束的绝对时间：事件时间减去设备上报的 ended_ago（周期结束距上报的秒数）。
+    缺少事件时间时退回接收时间，并在记录中标注 ts_source=received。"""
+    try:
+        ended_ago = max(0.0, float(paras.get("ended_ago", 0)))
+    except (TypeError, ValueError):
+        ended_ago = 0.0
+    if event_time is not None:
+        return event_time - ended_ago, "event"
+    return received - ended_ago, "received"
+
+
+def parse_time_arg(name: str, default: float) -> Optional[float]:
+    value = request.args.get(name)
+    if value is None or value == "":
+        return default
+    try:
+        return float(value)
+    except ValueError:
+        return None
+
+
+@app.route("/api/cycles", methods=["POST"])
+def api_cycles_ingest():
+    token = request.headers.get("X-Ingest-Token") or request.args.get("token")
+    if token != INGEST_TOKEN and not session.get("authed"):
+        return jsonify({"error": "unauthorized"}), 401
+    data = request.get_json(force=True, silent=True)
+    summaries = extract_cycle_summaries(data)
+    if not summaries:
+        return jsonify({"error": "no cycle_summary found"}), 400
+    records = []
+    for index, (paras, event_time) in enumerate(summaries):
+        record, error = validate_cycle(paras)
+        if record is None:
+            # 整批拒绝，不留下只写入一部分的推送
+            return jsonify({"error": f"cycle_summary[{index}]: {error}"}), 400
+        records.append((record, event_time))
+    received = time.time()
+    stored = []
+    for record, event_time in records:
+        ts, source = cycle_end_time(record, event_time, received)
+        stored.append(cycle_store.append({"device_id": DEVICE_ID, **record, "ts_source": source}, ts))
+    return jsonify({"ok": True, "stored": len(stored)})
+
+
+@app.route("/api/history", methods=["GET"])
+def api_history():
+    if not session.get("authed"):
+        return jsonify({"error": "unauthorized"}), 401
+    now = time.time()
+    start = parse_time_arg("start", now - 7 * 86400)
+    end = parse_time_arg("end", now)
+    if start is None or end is None:
+        return jsonify({"error": "start/end must be unix timestamps"}), 400
+    try:
+        limit = max(1, min(int(request.args.get("limit", HISTORY_MAX_ITEMS)), HISTORY_MAX_ITEMS))
+    except ValueError:
+        return jsonify({"error": "invalid limit"}), 400
+    items, totals = cycle_store.query(start, end, limit)
+    return jsonify({"items": items, "totals": totals, "truncated": totals["cycles"] > len(items),
+                    "start": start, "end": end})
+
+
 @app.route("/api/state", methods=["GET"])
 def api_state():
     if not session.get("authed"):
@@ -103,7 +339,7 @@ def api_command():
     data = request.get_json(force=True, silent=True) or {}
     command_name = data.get("command_name")
     paras = data.get("paras", {}) if isinstance(data.get("paras", {}), dict) else {}
-    if command_name not in ("start", "stop", "toggle", "set_mode", "switch_mode"):
+    if command_name not in ("start", "stop", "toggle", "set_mode", "switch_mode", "get_trace", "dump_trace", "inject_hang"):
         return jsonify({"error": "invalid command_name"}), 400
     try:
         resp = iotda_send_command(command_name, paras)